@@ -10,6 +10,12 @@
 // Increase the EEPROM size for layout options
 #define VIA_EEPROM_LAYOUT_OPTIONS_SIZE 2
 
+// The tamagotchi save journal takes the top of EEPROM; dynamic keymap
+// macros end below it, so the keymap itself stays where it was
+#define HLC_JOURNAL_SIZE 256
+#define DYNAMIC_KEYMAP_EEPROM_MAX_ADDR (TOTAL_EEPROM_BYTE_COUNT - HLC_JOURNAL_SIZE - 1)
+#define HLC_JOURNAL_SLOT_SIZE 40  // fits a full game state snapshot
+
 #define RGB_MATRIX_FRAMEBUFFER_EFFECTS
 #define RGB_MATRIX_KEYPRESSES
 
@@ -17,6 +23,9 @@
 
 #define SPLIT_WPM_ENABLE
 
+// Keypresses forwarded to the tamagotchi when it runs on the non-USB half
+#define SPLIT_TRANSACTION_IDS_USER TAMA_KEY_SYNC
+
 // Disable default layer/lock display — tamagotchi replaces it
 #define HLC_DISABLE_DEFAULT_DISPLAY
 
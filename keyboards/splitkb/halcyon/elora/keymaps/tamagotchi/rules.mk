@@ -8,4 +8,11 @@ ENCODER_MAP_ENABLE = yes
 USER_NAME := halcyon_modules
 
 WPM_ENABLE = yes
-SRC += tamagotchi.c
\ No newline at end of file
+SRC += tamagotchi.c
+
+# Game saves go through the halcyon_modules save journal
+HLC_JOURNAL_ENABLE = yes
+
+# Experimental, untested on hardware: uncomment to run the game and its
+# drawing on the RP2040's second core
+# HLC_CORE1_ENABLE = yes
@@ -3,8 +3,36 @@
 // Sprites extracted from "Cat Sprite Sheet.png".
 
 #include "hlc_tft_display/hlc_tft_display.h"
+#include "hlc_tft_display/hlc_random.h"
+#include "hlc_perf.h"
+#include "hlc_journal.h"
+#include "hlc_core1.h"
 #include "eeprom.h"
+
+#ifndef HLC_JOURNAL_ENABLE
+#    error "tamagotchi saves need HLC_JOURNAL_ENABLE = yes in rules.mk"
+#endif
+#ifdef SPLIT_KEYBOARD
+#    include "transactions.h"
+#endif
 #include <stdlib.h>
+#include <string.h>
+
+// ─── Clock ───
+// Every time in this file, core0's key stamps included, comes from one
+// clock. With HLC_CORE1_ENABLE that is hlc_core1_ms(): timer_read32()
+// keeps state and is not safe on core1 (see hlc_core1.h).
+static inline uint32_t tama_now(void) {
+#ifdef HLC_CORE1_ENABLE
+    return hlc_core1_ms();
+#else
+    return timer_read32();
+#endif
+}
+
+static inline uint32_t tama_elapsed(uint32_t t) {
+    return tama_now() - t;
+}
 
 // ─── Screen ───
 #define SCR_W 135
@@ -51,21 +79,35 @@
 #define XP_BAR_W    (SCR_W - 2 * XP_BAR_PAD)   // 127
 
 // ─── Timing & gameplay ───
-#define FRAME_MS        100     // 10 FPS
+#define TICK_MS         100     // game step: motion and animation counters advance per tick
+#define SLOW_TICKS      6       // sleeping/dead: one frame per 6 ticks (~1.7 FPS)
+#define RENDER_MS       100     // frame period while anything moves; below TICK_MS, frames interpolate
+#define FAST_RENDER_MS  50      // frame period while the orange cat runs or the cat pounces (20 FPS)
+#define MAX_CATCHUP     5       // ticks of backlog kept before dropping time
+#define SLICE_US        400     // display work per housekeeping pass, then yield
+#define QUIET_FRAMES    8       // slow frames before the panel shows only the cat's band
 #define DRAIN_MS        108000  // −1 HP every 108 s (~3 h full→dead)
 #define IDLE_SLEEP_MS   600000  // 10 min idle → sleep
-#define MAX_ICONS       3
+#define MAX_ICONS       32      // icon pool; bursts at high WPM fill it
+#define SAVED_ICONS     3       // icons kept across a power cycle
 #define MAX_HEALTH      100
 #define REVIVE_HEALTH   20
 #define ICON_HP_GAIN    5
-#define MOVE_SPEED      2       // px/frame (compensates for 5 FPS)
+#define MOVE_SPEED      2       // px/tick
 #define POUNCE_DIST     40      // Manhattan px to start chasing icon
-#define OVERLAY_PAD     16      // extra px above cat for zzz/? restore
+#define TYPING_MS       1500    // a press this recent counts as typing
+#define XP_PER_KEY      120     // at W wpm, W/120 presses a tick: the old xp += wpm
+#define ICON_KEYS_MIN   10      // presses between icon spawns: 10..19
+#define ICON_KEYS_RANGE 10
+#define ICON_MIN_MS     1000    // and never faster than this
 
 // ─── EEPROM persistence ───
-#define SAVE_ADDR       4080    // high address to avoid Vial/VIA conflicts
-#define SAVE_MAGIC      0xCA7E  // validation marker ("CATe")
+#define SAVE_PROGRESS   1       // hlc_journal record: [level:2][xp:4] (read only, older builds)
+#define SAVE_SNAPSHOT   2       // hlc_journal record: [version:1][gen:1][fields]
+#define SAVE_DELTA      3       // hlc_journal record: [gen:1][changed:3][changed fields]
 #define SAVE_INTERVAL   300000  // auto-save every 5 minutes
+#define LEGACY_ADDR     4080    // pre-journal layout: [magic:2][level:2][xp:4]
+#define LEGACY_MAGIC    0xCA7E
 
 // ─── Animation states ───
 enum {
@@ -75,6 +117,7 @@ enum {
     ANIM_SLEEP,      // lying down (idle ≥ 10 min)
     ANIM_DEAD,       // lying down, dim
     ANIM_FLEE,       // running away from orange cat
+    ANIM_COUNT,
 };
 
 // ─── Orange cat encounter phases ───
@@ -84,6 +127,7 @@ enum {
     ORANGE_IDLE,     // pauses, looks at main cat
     ORANGE_MAD,      // angry animation
     ORANGE_CHASE,    // main cat flees
+    ORANGE_COUNT,
 };
 
 // ─── Orange encounter timing ───
@@ -222,39 +266,201 @@ static const uint8_t glyph_e[5] = {0x07,0x04,0x07,0x04,0x07};
 static const uint8_t glyph_a[5] = {0x02,0x05,0x07,0x05,0x05};
 
 
+// ═══════════════════════════════════════════════════════════════════════
+// SPRITE ATLAS — cat frames pre-decoded for direct framebuffer blits
+// Built once at init: every palette/brightness tier resolved to native
+// RGB565, every frame row reduced to its opaque spans.
+// ═══════════════════════════════════════════════════════════════════════
+
+// Palette × brightness combinations the renderer uses
+enum {
+    TIER_CAT = 0,       // healthy
+    TIER_CAT_WEAK,      // health < 30
+    TIER_CAT_DEAD,      // dead, dim
+    TIER_ORANGE,        // orange intruder
+    TIER_COUNT,
+};
+
+static const struct {
+    const uint8_t (*palette)[3];
+    uint8_t brightness;
+} tier_defs[TIER_COUNT] = {
+    {cat_palette, 255}, {cat_palette, 140}, {cat_palette, 80}, {orange_palette, 255},
+};
+
+static uint16_t tier_colors[TIER_COUNT][4];
+
+// Every animation the atlas holds, listed once: the table and the frame
+// count below are both generated from it
+#define ATLAS_ANIMS(X) X(anim_walk) X(anim_trot) X(anim_sit) X(anim_sleep) X(anim_angry)
+#define ANIM_FRAMES(a) (sizeof(a) / sizeof((a)[0]))
+#define ATLAS_ENTRY(a) {a, ANIM_FRAMES(a)},
+#define ATLAS_COUNT(a) + ANIM_FRAMES(a)
+
+static const struct {
+    const uint32_t (*frames)[16];
+    uint8_t count;
+} atlas_anims[] = {ATLAS_ANIMS(ATLAS_ENTRY)};
+
+#define ATLAS_FRAMES    (0 ATLAS_ANIMS(ATLAS_COUNT))
+#define ATLAS_MAX_SPANS 4       // most opaque runs found in any sprite row
+_Static_assert(ATLAS_FRAMES <= UINT8_MAX, "atlas indices are uint8_t");
+
+typedef struct {
+    uint8_t n;                          // opaque spans in this row
+    uint8_t start[ATLAS_MAX_SPANS];     // first column (unmirrored)
+    uint8_t len[ATLAS_MAX_SPANS];
+} atlas_row_t;
+
+typedef struct {
+    const uint32_t *bits;
+    uint8_t top, bottom;                // first/last non-empty rows
+    uint8_t next;                       // atlas index of the animation's next frame
+    uint16_t delta;                     // rows that differ from that frame, bit 0 = top
+    atlas_row_t rows[CAT_BMP_H];
+} atlas_frame_t;
+
+static atlas_frame_t atlas[ATLAS_FRAMES];
+
+static void atlas_init(void) {
+    for (int t = 0; t < TIER_COUNT; t++) {
+        tier_colors[t][0] = 0;
+        for (int c = 1; c < 4; c++) {
+            const uint8_t *pal = tier_defs[t].palette[c];
+            uint8_t v = (uint16_t)pal[2] * tier_defs[t].brightness / 255;
+            tier_colors[t][c] = hlc_native_color(pal[0], pal[1], v);
+        }
+    }
+
+    // A row with more runs than ATLAS_MAX_SPANS would lose pixels. Its frame
+    // is left out of the atlas instead, so the cat is not drawn at all
+    // rather than drawn wrong, and the simulator (ATLAS_STRICT) stops.
+    atlas_frame_t *af = atlas;
+    for (size_t a = 0; a < sizeof(atlas_anims) / sizeof(atlas_anims[0]); a++) {
+        uint8_t first = af - atlas, count = atlas_anims[a].count;
+        for (int f = 0; f < count; f++, af++) {
+            const uint32_t *frame = atlas_anims[a].frames[f];
+            bool fits = true;
+            af->next = first + (f + 1) % count;
+            af->delta = 0;
+            for (int row = 0; row < CAT_BMP_H; row++)
+                if (frame[row] != atlas_anims[a].frames[(f + 1) % count][row])
+                    af->delta |= 1 << row;
+            af->top = CAT_BMP_H;
+            af->bottom = 0;
+            for (int row = 0; row < CAT_BMP_H; row++) {
+                uint32_t bits = frame[row];
+                atlas_row_t *ar = &af->rows[row];
+                ar->n = 0;
+                if (!bits) continue;
+                if (af->top == CAT_BMP_H) af->top = row;
+                af->bottom = row;
+                int col = 0;
+                while (col < CAT_BMP_W) {
+                    if (!((bits >> (2 * (CAT_BMP_W - 1 - col))) & 3)) { col++; continue; }
+                    int run = 1;
+                    while (col + run < CAT_BMP_W &&
+                           ((bits >> (2 * (CAT_BMP_W - 1 - col - run))) & 3)) run++;
+                    if (ar->n == ATLAS_MAX_SPANS) {
+                        uprintf("atlas: frame %d row %d needs more than %d spans\n",
+                                (int)(af - atlas), row, ATLAS_MAX_SPANS);
+#ifdef ATLAS_STRICT
+                        fflush(NULL);
+                        abort();
+#endif
+                        fits = false;
+                        break;
+                    }
+                    ar->start[ar->n] = col;
+                    ar->len[ar->n] = run;
+                    ar->n++;
+                    col += run;
+                }
+            }
+            af->bits = fits ? frame : NULL;
+        }
+    }
+}
+
+static const atlas_frame_t *atlas_lookup(const uint32_t *sprite) {
+    const atlas_frame_t *af = atlas;
+    for (size_t a = 0; a < sizeof(atlas_anims) / sizeof(atlas_anims[0]); a++) {
+        const uint32_t *first = atlas_anims[a].frames[0];
+        if (sprite >= first && sprite < first + atlas_anims[a].count * CAT_BMP_H) {
+            af += (sprite - first) / CAT_BMP_H;
+            return af->bits ? af : NULL;  // NULL: the frame did not fit the atlas
+        }
+        af += atlas_anims[a].count;
+    }
+    return NULL;
+}
+
+// ─── Animation table ───
+// One descriptor per animation state and per encounter phase; build_scene
+// indexes it directly, so a new animation is a table row, not a branch.
+enum {
+    ANIM_QUIET = 1 << 0,    // changes slowly enough to be drawn at SLOW_TICKS
+};
+
+typedef struct {
+    const uint32_t (*frames)[16];
+    uint8_t count;          // frames, played in a loop
+    uint8_t ticks;          // game ticks per frame
+    uint8_t hints;          // ANIM_QUIET
+} anim_def_t;
+
+static const anim_def_t cat_anims[ANIM_COUNT] = {
+    [ANIM_IDLE]  = {anim_sit,   4,  6, 0},
+    [ANIM_WALK]  = {anim_trot,  8,  3, 0},
+    [ANIM_SIT]   = {anim_walk,  4, 12, 0},
+    [ANIM_SLEEP] = {anim_sleep, 4,  8, ANIM_QUIET},
+    [ANIM_DEAD]  = {anim_sleep, 4,  8, ANIM_QUIET},
+    [ANIM_FLEE]  = {anim_trot,  8,  2, 0},
+};
+
+static const anim_def_t orange_anims[ORANGE_COUNT] = {
+    [ORANGE_ENTER] = {anim_trot, 8,  3, 0},
+    [ORANGE_IDLE]  = {anim_walk, 4, 10, 0},
+    [ORANGE_MAD]   = {anim_walk, 4,  8, 0},
+    [ORANGE_CHASE] = {anim_trot, 8,  2, 0},
+};
+
+// What the main cat plays during an encounter phase, over its own state
+static const anim_def_t cat_angry = {anim_angry, 8, 3, 0};
+static const anim_def_t *const orange_rival[ORANGE_COUNT] = {
+    [ORANGE_MAD] = &cat_angry, [ORANGE_CHASE] = &cat_angry,
+};
+
+static const uint32_t *anim_sprite(const anim_def_t *a, uint16_t frame) {
+    return a->frames[frame / a->ticks % a->count];
+}
+
 // ═══════════════════════════════════════════════════════════════════════
 // GAME STATE
 // ═══════════════════════════════════════════════════════════════════════
 
 typedef struct {
     int16_t  cat_x, cat_y;
-    int16_t  prev_cat_x, prev_cat_y;
     int16_t  target_x, target_y;
     uint16_t frame;
     bool     facing_left;
     bool     is_dead;
     uint16_t health;
     uint32_t last_drain;
-    uint32_t last_active;       // last time wpm > 0
+    uint32_t last_active;       // last keypress
     uint32_t last_icon_spawn;
     uint8_t  next_icon_type;
     uint8_t  anim_state;
     uint8_t  bounce_timer;      // frames remaining for eat-bounce
     uint8_t  prev_wpm;
     uint8_t  prev_half_hearts;
-    bool     prev_was_dead;
-    uint8_t  cur_wpm;               // cached WPM for current frame
-    const uint32_t *prev_sprite;    // previous cat sprite pointer (skip-redraw)
-    uint8_t  prev_cat_bright;       // previous cat brightness
-    bool     prev_cat_facing;       // previous facing direction
+    uint8_t  keys_to_icon;          // presses left before the next icon
 
     struct {
         int16_t x, y;
-        int16_t prev_x, prev_y;
         int8_t  dx, dy;
         uint8_t type;
         bool    active;
-        bool    prev_drawn;
     } icons[MAX_ICONS];
 
     // Level / XP
@@ -268,10 +474,6 @@ typedef struct {
     // Orange cat encounter
     uint8_t  orange_phase;
     int16_t  orange_x, orange_y;
-    int16_t  prev_orange_x, prev_orange_y;
-    bool     prev_orange_drawn;
-    const uint32_t *prev_orange_sprite;
-    bool     prev_orange_facing;
     int16_t  orange_target_x;
     uint16_t orange_frame;
     bool     orange_facing_left;
@@ -281,154 +483,432 @@ typedef struct {
 
 static tama_state_t st;
 static bool tama_inited = false;
-static uint32_t last_frame_time = 0;
+static uint32_t tick_time = 0;      // start of the current game tick
+static uint32_t next_frame = 0;     // deadline of the next frame, on the tick grid
+static uint32_t seen_activity = 0;
+static uint8_t  cur_frame_ticks = 1;
+static uint8_t  quiet_frames = 0;
 static uint32_t last_save_time = 0;
 
+// ─── Inputs ───
+// What the game reads of QMK's state, taken once per pass; WPM only feeds
+// the readout, so it is taken once per frame. With HLC_CORE1_ENABLE core0
+// publishes it and core1 copies it (see CORE1).
+typedef struct {
+    uint32_t activity;      // last_matrix_activity_time()
+    uint8_t  wpm;           // get_current_wpm(), for the frame being drawn
+    bool     suspended;
+} inputs_t;
+
+static inputs_t in;
+
+// ─── Time slicing ───
+// A frame is built in stages (scene, compositing, bars, flush) and each
+// housekeeping pass runs work units until SLICE_US is spent; the next pass
+// resumes where it stopped. A unit is one game tick, one scanline, one bar
+// or one flushed row, so a pass overruns its slice by at most one unit.
+// The display module opens the pass and owns its deadline: the flush it
+// pumps before this keymap draws counts against the same slice.
+// In the render thread (HLC_RENDER_THREAD) a pass runs the whole frame and
+// the scheduler preempts it whenever the main loop needs the CPU.
+enum {
+    FRAME_IDLE = 0,     // waiting for the next frame to fall due
+    FRAME_SCENE,        // build the scene, queue what changed
+    FRAME_COMPOSE,      // recompose the queue a scanline at a time
+    FRAME_BARS,         // top bar and level bar
+    FRAME_FLUSH,        // hand the damage to the (sliced) flush or to core0
+};
+
+static uint8_t  frame_stage = FRAME_IDLE;
+static uint32_t slice_end = 0;      // µs deadline of the current pass
+static uint32_t frame_us = 0;       // profiler: work time of the frame so far
+static uint32_t compose_us = 0;
+
+static bool slice_over(void) {
+#ifdef HLC_RENDER_THREAD
+    return false;  // the render thread is preempted by the scheduler instead
+#else
+    return (int32_t)(hlc_us_now() - slice_end) >= 0;
+#endif
+}
+
+// ─── Interpolation ───
+// Frames between ticks run the screen one tick behind the game: a lagging
+// frame shows the state from before the last tick (shown), with the moving
+// sprites drawn part of the way to their positions after it, by how far
+// the clock is into the tick. The sprite frame, bounce and icons all come
+// from that one state, so the cat reaches an icon on screen in the same
+// frame the icon goes. A jump longer than INTERP_SNAP is not interpolated:
+// a spawn, the orange cat entering, a restore.
+//
+// Frames on the tick grid draw the current state, with no lag. With
+// RENDER_MS below TICK_MS every frame lags; otherwise only FAST_RENDER_MS
+// stretches do. A stretch starts at a tick boundary, where the lagging
+// frame shows the same state the last one did, so time never steps back.
+#define INTERP      (RENDER_MS < TICK_MS)
+_Static_assert(TICK_MS % FAST_RENDER_MS == 0, "fast frames must split a tick evenly");
+#define INTERP_SNAP 8
+
+static tama_state_t shown;          // the state before the last tick
+static bool    lagging = INTERP;    // this frame draws shown, interpolated
+static uint8_t interp_t = 0;        // ms into the current tick at draw time
+static bool    pouncing = false;    // the cat is after an icon this tick
+
+static void interp_begin_tick(void) {
+    shown = st;
+}
+
+static int16_t interp(int16_t prev, int16_t cur) {
+    int16_t d = cur - prev;
+    if (d > INTERP_SNAP || d < -INTERP_SNAP) return cur;
+    return prev + d * interp_t / TICK_MS;
+}
+
 // ─── EEPROM save/load ───
-// Layout at SAVE_ADDR: [magic:2][level:2][xp:4] = 8 bytes
-static void save_progress(void) {
-    eeprom_update_word((uint16_t *)SAVE_ADDR, SAVE_MAGIC);
-    eeprom_update_word((uint16_t *)(SAVE_ADDR + 2), st.level);
-    eeprom_update_dword((uint32_t *)(SAVE_ADDR + 4), st.xp);
-}
-
-static bool load_progress(void) {
-    if (eeprom_read_word((uint16_t *)SAVE_ADDR) != SAVE_MAGIC) return false;
-    st.level = eeprom_read_word((uint16_t *)(SAVE_ADDR + 2));
-    st.xp    = eeprom_read_dword((uint32_t *)(SAVE_ADDR + 4));
-    if (st.level == 0) st.level = 1;
+// The whole game state is saved through hlc_journal as a bit-packed
+// snapshot plus at most one delta: the fields that differ from that
+// snapshot. Restoring is the newest snapshot with its delta applied. A
+// delta that would grow past half a snapshot is replaced by a new one.
+//
+// Schema: fields are only ever appended to STATE_FIELDS. A snapshot
+// stores its field count as its version; fields it predates keep the
+// values module_post_init_user() set, and the next save is a snapshot.
+// Timers are saved as ages, so time spent powered off does not count.
+// Ages change with the clock alone, so they do not make a save: they are
+// written along with the next change to any other field.
+#define STATE_FIELDS(X)                                                         \
+    X(CAT_X, 8) X(CAT_Y, 8) X(TARGET_X, 8) X(TARGET_Y, 8) X(FACING, 1)          \
+    X(DEAD, 1) X(HEALTH, 7) X(DRAIN_AGE, 11) X(IDLE_AGE, 16) X(SPAWN_AGE, 7)    \
+    X(NEXT_ICON, 2) X(LEVEL, 16) X(XP, 32) X(ICON0, 25) X(ICON1, 25)            \
+    X(ICON2, 25) X(ORANGE_PHASE, 3) X(ORANGE_X, 9) X(ORANGE_Y, 8)               \
+    X(ORANGE_TX, 8) X(ORANGE_FACING, 1) X(ORANGE_AGE, 8) X(ORANGE_CHECK_AGE, 10)
+
+#define FIELD_ID(name, bits) F_##name,
+#define FIELD_BITS(name, bits) bits,
+#define FIELD_SUM(name, bits) + bits
+enum { STATE_FIELDS(FIELD_ID) F_COUNT };
+static const uint8_t field_bits[F_COUNT] = {STATE_FIELDS(FIELD_BITS)};
+#define SNAP_BYTES  (2 + ((0 STATE_FIELDS(FIELD_SUM)) + 7) / 8)
+#define DELTA_MASK  ((F_COUNT + 7) / 8)
+
+#define AGE_FIELDS  (1UL << F_DRAIN_AGE | 1UL << F_IDLE_AGE | 1UL << F_SPAWN_AGE | \
+                     1UL << F_ORANGE_AGE | 1UL << F_ORANGE_CHECK_AGE)
+
+_Static_assert(SNAP_BYTES <= HLC_JOURNAL_DATA_MAX, "snapshot does not fit a journal slot");
+_Static_assert(F_COUNT <= 8 * DELTA_MASK && DELTA_MASK <= 4, "delta mask too small");
+
+static uint32_t snap[F_COUNT];   // fields of the newest snapshot
+static uint8_t  snap_gen = 0;
+static bool     snap_valid = false;
+static uint32_t saved[F_COUNT];  // fields of the newest record, snapshot or delta
+static bool     saved_valid = false;
+
+typedef struct {
+    uint8_t *buf;
+    uint16_t pos;  // bit position
+} bits_t;
+
+static void bits_put(bits_t *b, uint32_t v, uint8_t n) {
+    for (uint8_t i = 0; i < n; i++, b->pos++)
+        if ((v >> i) & 1) b->buf[b->pos >> 3] |= 1 << (b->pos & 7);
+}
+
+static uint32_t bits_get(bits_t *b, uint8_t n) {
+    uint32_t v = 0;
+    for (uint8_t i = 0; i < n; i++, b->pos++)
+        v |= (uint32_t)((b->buf[b->pos >> 3] >> (b->pos & 7)) & 1) << i;
+    return v;
+}
+
+// Elapsed time in units, saturating at max
+static uint32_t age_of(uint32_t t, uint32_t unit, uint32_t max) {
+    uint32_t a = tama_elapsed(t) / unit;
+    return a > max ? max : a;
+}
+
+static uint32_t clamp_field(int32_t v, int32_t lo, int32_t hi) {
+    return v < lo ? lo : v > hi ? hi : v;
+}
+
+// Icon: [x:8][y:8][dx+4:3][dy+4:3][type:2][active:1]
+static uint32_t icon_field(int i) {
+    if (!st.icons[i].active) return 0;
+    return st.icons[i].x | (uint32_t)st.icons[i].y << 8 | (uint32_t)(st.icons[i].dx + 4) << 16 |
+           (uint32_t)(st.icons[i].dy + 4) << 19 | (uint32_t)st.icons[i].type << 22 | 1UL << 24;
+}
+
+static void state_capture(uint32_t *v) {
+    v[F_CAT_X]     = st.cat_x;
+    v[F_CAT_Y]     = st.cat_y;
+    v[F_TARGET_X]  = st.target_x;
+    v[F_TARGET_Y]  = st.target_y;
+    v[F_FACING]    = st.facing_left;
+    v[F_DEAD]      = st.is_dead;
+    v[F_HEALTH]    = st.health;
+    v[F_DRAIN_AGE] = age_of(st.last_drain, 100, 2047);
+    v[F_IDLE_AGE]  = age_of(st.last_active, 1000, 65535);
+    v[F_SPAWN_AGE] = age_of(st.last_icon_spawn, 100, 127);
+    v[F_NEXT_ICON] = st.next_icon_type;
+    v[F_LEVEL]     = st.level;
+    v[F_XP]        = st.xp;
+    for (int i = 0, k = 0; i < MAX_ICONS && k < SAVED_ICONS; i++)
+        if (st.icons[i].active) v[F_ICON0 + k++] = icon_field(i);
+    v[F_ORANGE_PHASE]     = st.orange_phase;
+    v[F_ORANGE_X]         = st.orange_x + CAT_W;
+    v[F_ORANGE_Y]         = st.orange_y;
+    v[F_ORANGE_TX]        = st.orange_target_x;
+    v[F_ORANGE_FACING]    = st.orange_facing_left;
+    v[F_ORANGE_AGE]       = age_of(st.orange_phase_timer, 100, 255);
+    v[F_ORANGE_CHECK_AGE] = age_of(st.last_orange_check, 100, 1023);
+}
+
+// Inverse of state_capture, clamping anything a bad record could put off screen
+static void state_apply(const uint32_t *v) {
+    uint32_t now = tama_now();
+    st.cat_x           = clamp_field(v[F_CAT_X], 0, SCR_W - CAT_W);
+    st.cat_y           = clamp_field(v[F_CAT_Y], GAME_Y, GAME_Y + GAME_H - CAT_H);
+    st.target_x        = clamp_field(v[F_TARGET_X], 0, SCR_W - CAT_W);
+    st.target_y        = clamp_field(v[F_TARGET_Y], GAME_Y, GAME_Y + GAME_H - CAT_H);
+    st.facing_left     = v[F_FACING];
+    st.is_dead         = v[F_DEAD];
+    st.health          = clamp_field(v[F_HEALTH], 0, MAX_HEALTH);
+    st.last_drain      = now - v[F_DRAIN_AGE] * 100;
+    st.last_active     = now - v[F_IDLE_AGE] * 1000;
+    st.last_icon_spawn = now - v[F_SPAWN_AGE] * 100;
+    st.next_icon_type  = v[F_NEXT_ICON] % 3;
+    st.level           = v[F_LEVEL] ? v[F_LEVEL] : 1;
+    st.xp              = v[F_XP];
+    for (int i = 0; i < SAVED_ICONS; i++) {
+        uint32_t f = v[F_ICON0 + i];
+        st.icons[i].active = (f >> 24) & 1;
+        st.icons[i].x      = clamp_field(f & 0xFF, 0, SCR_W - ICON_W);
+        st.icons[i].y      = clamp_field((f >> 8) & 0xFF, GAME_Y, GAME_Y + GAME_H - ICON_H);
+        st.icons[i].dx     = (int8_t)((f >> 16) & 7) - 4;
+        st.icons[i].dy     = (int8_t)((f >> 19) & 7) - 4;
+        st.icons[i].type   = ((f >> 22) & 3) % 3;
+    }
+    st.orange_phase       = v[F_ORANGE_PHASE] <= ORANGE_CHASE ? v[F_ORANGE_PHASE] : ORANGE_NONE;
+    st.orange_x           = (int16_t)v[F_ORANGE_X] - CAT_W;
+    st.orange_y           = clamp_field(v[F_ORANGE_Y], GAME_Y, GAME_Y + GAME_H - CAT_H);
+    st.orange_target_x    = clamp_field(v[F_ORANGE_TX], 0, SCR_W - CAT_W);
+    st.orange_facing_left = v[F_ORANGE_FACING];
+    st.orange_phase_timer = now - v[F_ORANGE_AGE] * 100;
+    st.last_orange_check  = now - v[F_ORANGE_CHECK_AGE] * 100;
+}
+
+// Stage a delta against the newest snapshot, or a new snapshot when there
+// is none or the delta would be too large. hlc_journal writes it later.
+// Nothing is staged when only ages moved since the newest record.
+static void save_state(void) {
+    uint32_t v[F_COUNT];
+    uint8_t  rec[SNAP_BYTES] = {0};
+    bits_t   b = {rec, 0};
+    state_capture(v);
+
+    if (saved_valid) {
+        int i = 0;
+        while (i < F_COUNT && (v[i] == saved[i] || ((AGE_FIELDS >> i) & 1))) i++;
+        if (i == F_COUNT) return;
+    }
+    memcpy(saved, v, sizeof(saved));
+    saved_valid = true;
+
+    if (snap_valid) {
+        uint32_t changed = 0;
+        uint16_t bits    = 0;
+        for (int i = 0; i < F_COUNT; i++) {
+            if (v[i] == snap[i]) continue;
+            changed |= 1UL << i;
+            bits += field_bits[i];
+        }
+        uint8_t len = 1 + DELTA_MASK + (bits + 7) / 8;
+        if (len <= SNAP_BYTES / 2) {
+            bits_put(&b, snap_gen, 8);
+            bits_put(&b, changed, 8 * DELTA_MASK);
+            for (int i = 0; i < F_COUNT; i++)
+                if ((changed >> i) & 1) bits_put(&b, v[i], field_bits[i]);
+            hlc_journal_append(SAVE_DELTA, rec, len);
+            return;
+        }
+    }
+
+    snap_gen++;
+    bits_put(&b, F_COUNT, 8);
+    bits_put(&b, snap_gen, 8);
+    for (int i = 0; i < F_COUNT; i++) bits_put(&b, v[i], field_bits[i]);
+    hlc_journal_append(SAVE_SNAPSHOT, rec, SNAP_BYTES);
+    memcpy(snap, v, sizeof(snap));
+    snap_valid = true;
+}
+
+// Restore over the defaults already in st. A snapshot from an older
+// schema has fewer fields; the delta only applies to its own snapshot.
+static bool load_state(void) {
+    uint32_t v[F_COUNT];
+    uint8_t  rec[HLC_JOURNAL_DATA_MAX] = {0};
+    state_capture(v);
+
+    uint8_t len = hlc_journal_latest(SAVE_SNAPSHOT, rec, sizeof(rec));
+    uint8_t n   = rec[0];
+    uint16_t bits = 0;
+    for (uint8_t i = 0; len && i < n && i < F_COUNT; i++) bits += field_bits[i];
+
+    if (len >= 2 && n <= F_COUNT && len == 2 + (bits + 7) / 8) {
+        bits_t b = {rec, 16};
+        for (uint8_t i = 0; i < n; i++) v[i] = bits_get(&b, field_bits[i]);
+        snap_gen = rec[1];
+        memcpy(snap, v, sizeof(snap));
+        snap_valid = n == F_COUNT;  // older schema: next save is a full snapshot
+
+        len = hlc_journal_latest(SAVE_DELTA, rec, sizeof(rec));
+        if (len > DELTA_MASK && rec[0] == snap_gen) {
+            b = (bits_t){rec, 8};
+            uint32_t changed = bits_get(&b, 8 * DELTA_MASK);
+            bits = 0;
+            for (int i = 0; i < F_COUNT; i++)
+                if ((changed >> i) & 1) bits += field_bits[i];
+            if (len == 1 + DELTA_MASK + (bits + 7) / 8 && !(changed >> n)) {
+                for (int i = 0; i < F_COUNT; i++)
+                    if ((changed >> i) & 1) v[i] = bits_get(&b, field_bits[i]);
+            }
+        }
+    } else if (hlc_journal_latest(SAVE_PROGRESS, rec, sizeof(rec)) == 6) {
+        v[F_LEVEL] = rec[0] | rec[1] << 8;
+        v[F_XP]    = rec[2] | rec[3] << 8 | (uint32_t)rec[4] << 16 | (uint32_t)rec[5] << 24;
+    } else if (eeprom_read_word((uint16_t *)LEGACY_ADDR) == LEGACY_MAGIC) {
+        // Carry progress over from the old fixed address once
+        v[F_LEVEL] = eeprom_read_word((uint16_t *)(LEGACY_ADDR + 2));
+        v[F_XP]    = eeprom_read_dword((uint32_t *)(LEGACY_ADDR + 4));
+    } else {
+        return false;
+    }
+    state_apply(v);
+    memcpy(saved, v, sizeof(saved));
+    saved_valid = snap_valid;  // a save from an older layout is rewritten at the next change
     return true;
 }
 
-// ─── Frame timing instrumentation ───
-// Displays ms/frame in bottom-right corner.
-// Remove this block once performance is verified.
-#define SHOW_FRAME_TIMING 0
-#if SHOW_FRAME_TIMING
-static uint8_t last_frame_ms = 0;
-#endif
+// ─── Profiler phases ───
+// Timed with hlc_perf when HLC_PERF_ENABLE is defined in config.h.
+enum {
+    PERF_UPDATE,    // update_game()
+    PERF_SCENE,     // sprite list for the game area
+    PERF_COMPOSE,   // scanline compositing of changed rects, all slices
+    PERF_TOPBAR,    // WPM + hearts
+    PERF_LVLBAR,    // level / XP bar
+    PERF_FLUSH,     // damaged windows to the panel, first slice
+    PERF_FRAME,     // whole frame, scene to flush, all slices
+    PERF_PARTICLES, // particle pool step, once per tick
+    PERF_KEYHOOK,   // process_record_user, per keypress
+    PERF_PASS,      // one housekeeping pass: the main loop's wait for us
+};
+
+static void perf_register_phases(void) {
+    hlc_perf_register(PERF_UPDATE,  "update");
+    hlc_perf_register(PERF_SCENE,   "scene");
+    hlc_perf_register(PERF_COMPOSE, "compose");
+    hlc_perf_register(PERF_TOPBAR,  "topbar");
+    hlc_perf_register(PERF_LVLBAR,  "lvlbar");
+    hlc_perf_register(PERF_FLUSH,   "flush");
+    hlc_perf_register(PERF_FRAME,   "frame");
+    hlc_perf_register(PERF_PARTICLES, "particles");
+    hlc_perf_register(PERF_KEYHOOK,   "keyhook");
+    hlc_perf_register(PERF_PASS,      "pass");
+}
 
 // ═══════════════════════════════════════════════════════════════════════
 // DRAWING HELPERS
 // ═══════════════════════════════════════════════════════════════════════
 
-// Clear a rectangle to black (game area only)
-static void clear_rect(int16_t x, int16_t y, int16_t w, int16_t h) {
-    int16_t x1 = (x < 0) ? 0 : x;
-    int16_t y1 = (y < GAME_Y) ? GAME_Y : y;
-    int16_t x2 = x + w - 1; if (x2 >= SCR_W) x2 = SCR_W - 1;
-    int16_t y2 = y + h - 1; if (y2 >= LVL_Y) y2 = LVL_Y - 1;
-    if (x1 <= x2 && y1 <= y2)
-        qp_rect(lcd_surface, x1, y1, x2, y2, 0, 0, 0, true);
-}
-
-static void draw_cat(int16_t ox, int16_t oy, const uint32_t *sprite,
-                     bool mirror, uint8_t brightness,
-                     const uint8_t (*palette)[3]) {
-    for (int row = 0; row < CAT_BMP_H; row++) {
-        uint32_t bits = sprite[row];
-        if (!bits) continue;
-        int16_t py = oy + row * CAT_SCALE;
-        int16_t py2 = py + CAT_SCALE - 1;
-        if (py2 < GAME_Y || py >= LVL_Y) continue;  // row fully off-screen
-        if (py < GAME_Y) py = GAME_Y;
-        if (py2 >= LVL_Y) py2 = LVL_Y - 1;
-        int col = 0;
-        while (col < CAT_BMP_W) {
-            int src_col = mirror ? (CAT_BMP_W - 1 - col) : col;
-            uint8_t c = (bits >> (2 * (CAT_BMP_W - 1 - src_col))) & 3;
-            if (c == 0) { col++; continue; }
-            // Merge adjacent same-color pixels into one wider rect
-            int run = 1;
-            while (col + run < CAT_BMP_W) {
-                int ns = mirror ? (CAT_BMP_W - 1 - (col + run)) : (col + run);
-                if (((bits >> (2 * (CAT_BMP_W - 1 - ns))) & 3) != c) break;
-                run++;
-            }
-            int16_t px = ox + col * CAT_SCALE;
-            int16_t px2 = px + run * CAT_SCALE - 1;
-            if (px2 < 0 || px >= SCR_W) { col += run; continue; }  // fully off-screen horizontally
-            if (px < 0) px = 0;
-            if (px2 >= SCR_W) px2 = SCR_W - 1;
-            const uint8_t *pal = palette[c];
-            uint8_t v = (uint16_t)pal[2] * brightness / 255;
-            qp_rect(lcd_surface, px, py, px2, py2, pal[0], pal[1], v, true);
-            col += run;
-        }
+// Filled rect straight into the framebuffer, recorded as damage for the next flush
+static void fill_rect(int16_t x1, int16_t y1, int16_t x2, int16_t y2,
+                      uint8_t h, uint8_t s, uint8_t v) {
+    uint16_t c = hlc_native_color(h, s, v);
+    uint16_t *fb = (uint16_t *)lcd_surface_fb;
+    for (int16_t y = y1; y <= y2; y++) {
+        uint16_t *p = &fb[y * SCR_W + x1];
+        for (int16_t x = x1; x <= x2; x++) *p++ = c;
     }
+    hlc_damage_add(x1, y1, x2, y2);
 }
 
-static void draw_icon_sprite(int16_t ox, int16_t oy, const uint8_t *sprite,
-                              uint8_t h, uint8_t s, uint8_t v) {
-    for (int row = 0; row < ICON_BMP_H; row++) {
-        uint8_t bits = sprite[row];
-        if (!bits) continue;
-        int col = 0;
-        while (col < ICON_BMP_W) {
-            if (!(bits & (1 << (7 - col)))) { col++; continue; }
-            int run = 1;
-            while (col + run < ICON_BMP_W && (bits & (1 << (7 - col - run)))) run++;
-            int16_t px = ox + col * ICON_SCALE;
-            int16_t py = oy + row * ICON_SCALE;
-            qp_rect(lcd_surface, px, py,
-                     px + run * ICON_SCALE - 1, py + ICON_SCALE - 1,
-                     h, s, v, true);
-            col += run;
-        }
+// ─── Glyph tiles ───
+// Digits, "Lv" and hearts are rasterised once into native RGB565 tiles on a
+// black background (the bars are cleared black before text goes on), so
+// drawing text is one row copy per scanline instead of a qp_rect per run.
+#define GLYPH_W     3
+#define GLYPH_H     5
+#define WPM_TILE_W  (GLYPH_W * DIGIT_SCALE)
+#define WPM_TILE_H  (GLYPH_H * DIGIT_SCALE)
+#define LVL_TILE_W  (GLYPH_W * LVL_SCALE)
+#define LVL_TILE_H  (GLYPH_H * LVL_SCALE)
+#define LVL_TILE_L  10                      // after the ten digits
+#define LVL_TILE_V  11
+
+static uint16_t wpm_tiles[2][10][WPM_TILE_H][WPM_TILE_W];  // [typing][digit]
+static uint16_t lvl_tiles[12][LVL_TILE_H][LVL_TILE_W];     // digits, L, v
+static uint16_t heart_tiles[3][HEART_DISP][HEART_DISP];    // empty, half, full
+static int16_t  lvl_tiles_hue = -1;                         // hue lvl_tiles hold
+
+static void glyph_raster(uint16_t *tile, const uint8_t *glyph,
+                         uint8_t scale, uint16_t color) {
+    uint8_t w = GLYPH_W * scale;
+    for (int y = 0; y < GLYPH_H * scale; y++) {
+        uint8_t bits = glyph[y / scale];
+        for (int x = 0; x < w; x++)
+            *tile++ = (bits & (1 << (GLYPH_W - 1 - x / scale))) ? color : 0;
     }
 }
 
-static void draw_glyph(int16_t ox, int16_t oy, const uint8_t *glyph,
-                        uint8_t scale, uint8_t h, uint8_t s, uint8_t v) {
-    for (int row = 0; row < 5; row++) {
-        uint8_t bits = glyph[row];
-        if (!bits) continue;
-        int col = 0;
-        while (col < 3) {
-            if (!(bits & (1 << (2 - col)))) { col++; continue; }
-            int run = 1;
-            while (col + run < 3 && (bits & (1 << (2 - col - run)))) run++;
-            int16_t px = ox + col * scale;
-            int16_t py = oy + row * scale;
-            qp_rect(lcd_surface, px, py,
-                     px + run * scale - 1, py + scale - 1,
-                     h, s, v, true);
-            col += run;
+// Copy a w x h tile into the framebuffer at (ox, oy)
+static void tile_blit(int16_t ox, int16_t oy, const uint16_t *tile,
+                      uint8_t w, uint8_t h) {
+    uint16_t *fb = (uint16_t *)lcd_surface_fb;
+    for (int y = 0; y < h; y++, tile += w)
+        memcpy(&fb[(oy + y) * SCR_W + ox], tile, w * sizeof(uint16_t));
+    hlc_damage_add(ox, oy, ox + w - 1, oy + h - 1);
+}
+
+static void glyph_tiles_init(void) {
+    uint16_t wpm_color[2] = { hlc_native_color(0, 0, 80), hlc_native_color(0, 0, 200) };
+    for (int t = 0; t < 2; t++)
+        for (int d = 0; d < 10; d++)
+            glyph_raster(&wpm_tiles[t][d][0][0], digits_3x5[d], DIGIT_SCALE, wpm_color[t]);
+
+    uint16_t red = hlc_native_color(0, 255, 220), grey = hlc_native_color(0, 0, 60);
+    for (int fill = 0; fill < 3; fill++) {
+        for (int y = 0; y < HEART_DISP; y++) {
+            uint8_t row = y / HEART_SCALE;
+            for (int x = 0; x < HEART_DISP; x++) {
+                uint8_t col = x / HEART_SCALE;
+                uint8_t bit = 1 << (HEART_BMP - 1 - col);
+                bool in_full = heart_full[row] & bit;
+                bool in_outline = heart_empty[row] & bit;
+                uint16_t c = 0;
+                if (fill == 2 && in_full)                   c = red;
+                else if (fill == 1 && col < 4 && in_full)   c = red;
+                else if (fill < 2 && in_outline)            c = grey;
+                heart_tiles[fill][y][x] = c;
+            }
         }
     }
 }
 
-static void draw_digit(int16_t ox, int16_t oy, uint8_t digit,
-                        uint8_t h, uint8_t s, uint8_t v) {
-    if (digit <= 9) draw_glyph(ox, oy, digits_3x5[digit], DIGIT_SCALE, h, s, v);
+// Level text changes colour with the level tier: rebuilt when the hue moves
+static void lvl_tiles_build(uint8_t hue) {
+    if (lvl_tiles_hue == hue) return;
+    lvl_tiles_hue = hue;
+    uint16_t digit = hlc_native_color(hue, 200, 220);
+    uint16_t text  = hlc_native_color(hue, 180, 200);
+    for (int d = 0; d < 10; d++)
+        glyph_raster(&lvl_tiles[d][0][0], digits_3x5[d], LVL_SCALE, digit);
+    glyph_raster(&lvl_tiles[LVL_TILE_L][0][0], glyph_l, LVL_SCALE, text);
+    glyph_raster(&lvl_tiles[LVL_TILE_V][0][0], glyph_v, LVL_SCALE, text);
 }
 
 // fill: 0=empty, 1=half (left filled), 2=full — drawn at HEART_SCALE
 static void draw_heart(int16_t ox, int16_t oy, uint8_t fill) {
-    for (int row = 0; row < HEART_BMP; row++) {
-        for (int col = 0; col < HEART_BMP; col++) {
-            int bit = 1 << (6 - col);
-            bool in_full = heart_full[row] & bit;
-            bool in_outline = heart_empty[row] & bit;
-            uint8_t h = 0, s = 0, v = 0;
-            bool draw = false;
-            if (fill == 2 && in_full) {
-                s = 255; v = 220; draw = true;
-            } else if (fill == 1) {
-                if (col < 4 && in_full) { s = 255; v = 220; draw = true; }
-                else if (in_outline) { v = 60; draw = true; }
-            } else if (fill == 0 && in_outline) {
-                v = 60; draw = true;
-            }
-            if (draw) {
-                int16_t px = ox + col * HEART_SCALE;
-                int16_t py = oy + row * HEART_SCALE;
-                qp_rect(lcd_surface, px, py,
-                         px + HEART_SCALE - 1, py + HEART_SCALE - 1,
-                         h, s, v, true);
-            }
-        }
-    }
+    tile_blit(ox, oy, &heart_tiles[fill][0][0], HEART_DISP, HEART_DISP);
 }
 
 static void draw_wpm(uint8_t wpm) {
@@ -437,9 +917,9 @@ static void draw_wpm(uint8_t wpm) {
     int n = 3 - start;
     int total_w = n * 3 * DIGIT_SCALE + (n - 1) * DIGIT_SCALE;
     int16_t x = (SCR_W - total_w) / 2;
-    uint8_t v = (wpm > 0) ? 200 : 80;
+    uint8_t typing = wpm > 0;
     for (int i = start; i < 3; i++) {
-        draw_digit(x, WPM_Y, d[i], 0, 0, v);
+        tile_blit(x, WPM_Y, &wpm_tiles[typing][d[i]][0][0], WPM_TILE_W, WPM_TILE_H);
         x += 4 * DIGIT_SCALE;
     }
 }
@@ -471,7 +951,7 @@ static uint8_t level_hue(uint16_t level) {
 }
 
 static void draw_level_bar(uint16_t level, uint8_t bar_fill) {
-    qp_rect(lcd_surface, 0, LVL_Y, SCR_W - 1, SCR_H - 1, 0, 0, 0, true);
+    fill_rect(0, LVL_Y, SCR_W - 1, SCR_H - 1, 0, 0, 0);
 
     uint8_t hue = level_hue(level);
 
@@ -489,34 +969,433 @@ static void draw_level_bar(uint16_t level, uint8_t bar_fill) {
     int16_t x = (SCR_W - total_w) / 2;
     int16_t y = LVL_Y;
 
-    draw_glyph(x, y, glyph_l, LVL_SCALE, hue, 180, 200);
+    lvl_tiles_build(hue);
+    tile_blit(x, y, &lvl_tiles[LVL_TILE_L][0][0], LVL_TILE_W, LVL_TILE_H);
     x += 4 * LVL_SCALE;
-    draw_glyph(x, y, glyph_v, LVL_SCALE, hue, 180, 200);
+    tile_blit(x, y, &lvl_tiles[LVL_TILE_V][0][0], LVL_TILE_W, LVL_TILE_H);
     x += 4 * LVL_SCALE;
     for (int i = 0; i < nd; i++) {
-        draw_glyph(x, y, digits_3x5[digs[i]], LVL_SCALE, hue, 200, 220);
+        tile_blit(x, y, &lvl_tiles[digs[i]][0][0], LVL_TILE_W, LVL_TILE_H);
         x += 4 * LVL_SCALE;
     }
 
     // XP bar background
     int16_t bar_y = SCR_H - XP_BAR_H;
-    qp_rect(lcd_surface, XP_BAR_PAD, bar_y,
-             XP_BAR_PAD + XP_BAR_W - 1, bar_y + XP_BAR_H - 1,
-             0, 0, 30, true);
+    fill_rect(XP_BAR_PAD, bar_y,
+              XP_BAR_PAD + XP_BAR_W - 1, bar_y + XP_BAR_H - 1,
+              0, 0, 30);
     // XP bar fill
     if (bar_fill > 0) {
-        qp_rect(lcd_surface, XP_BAR_PAD, bar_y,
-                 XP_BAR_PAD + bar_fill - 1, bar_y + XP_BAR_H - 1,
-                 hue, 220, 180, true);
+        fill_rect(XP_BAR_PAD, bar_y,
+                  XP_BAR_PAD + bar_fill - 1, bar_y + XP_BAR_H - 1,
+                  hue, 220, 180);
         // Bright tip at fill edge
         if (bar_fill < XP_BAR_W)
-            qp_rect(lcd_surface, XP_BAR_PAD + bar_fill - 1, bar_y,
-                     XP_BAR_PAD + bar_fill - 1, bar_y + XP_BAR_H - 1,
-                     hue, 100, 255, true);
+            fill_rect(XP_BAR_PAD + bar_fill - 1, bar_y,
+                      XP_BAR_PAD + bar_fill - 1, bar_y + XP_BAR_H - 1,
+                      hue, 100, 255);
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// PARTICLES — crumbs when eating, confetti on level-up, dust in a chase
+// A fixed pool in struct-of-arrays form: Q6 positions and velocities are
+// stepped once per tick in one loop. Each frame the live particles are
+// bucketed by row and the compositor draws a row's bucket above the
+// sprites. The 8x8 cells a particle covered last frame or covers now are
+// recomposed, so moving particles leave nothing behind.
+// ═══════════════════════════════════════════════════════════════════════
+
+// The pool is sized for the RP2040, not the host. A game tick runs as one
+// unit of work, so the particles in it must fit a quarter slice:
+// SLICE_US / 4 at 125 MHz is 12500 cycles. Estimated Cortex-M0+ cycles
+// (2 per load or store, 1 per ALU op, 2 per taken branch):
+// particles_update ~70 per live particle (step 30, compact 40), part_emit
+// ~150 with its random velocity and hue. The worst tick is a level-up:
+// PART_LEVEL_UP emitted after a full pool has stepped, which leaves room
+// for 75. particles_bucket (~40 a particle) runs in the scene stage,
+// another unit, and is well inside. The recompose of the covered cells is
+// sliced by scanline, so more particles only spread it over more passes.
+// The "particles" hlc_perf phase measures the tick share on the board.
+#define PART_CPU_MHZ     125
+#define PART_BUDGET      (SLICE_US / 4 * PART_CPU_MHZ)  // cycles per tick
+#define PART_STEP_CYCLES 70                             // update + compact
+#define PART_EMIT_CYCLES 150
+#define PART_LEVEL_UP    48                             // largest burst
+#define PART_MAX     ((PART_BUDGET - PART_LEVEL_UP * PART_EMIT_CYCLES) / PART_STEP_CYCLES)
+#define PART_SHIFT   6                          // Q6 fixed point
+#define PART_ONE     (1 << PART_SHIFT)
+#define PART_SIZE    2                          // on-screen square, px
+#define PART_GRAVITY (PART_ONE / 4)             // added to vy each tick
+#define CELL_SHIFT   3
+#define CELL_COLS    ((SCR_W + 7) >> CELL_SHIFT)  // 17
+#define CELL_ROWS    (GAME_H >> CELL_SHIFT)       // 24
+
+static struct {
+    int16_t  x[PART_MAX], y[PART_MAX];      // Q6 screen position
+    int16_t  vx[PART_MAX], vy[PART_MAX];    // Q6 px per tick
+    uint8_t  life[PART_MAX];                // ticks left
+    uint16_t color[PART_MAX];               // native
+    uint16_t next[PART_MAX];                // row bucket chain, index + 1
+    uint16_t n;                             // live particles are [0, n)
+} parts;
+
+static uint16_t part_rows[GAME_H];          // first particle per row, index + 1
+static uint32_t part_cells[2][CELL_ROWS];   // covered cells: [0] on screen, [1] next
+
+static void part_emit(int16_t x, int16_t y, int16_t vx, int16_t vy,
+                      uint8_t life, uint16_t color) {
+    if (parts.n >= PART_MAX || x < 0 || x > SCR_W - PART_SIZE ||
+        y < GAME_Y || y > LVL_Y - PART_SIZE) return;
+    uint16_t i = parts.n++;
+    parts.x[i] = x * PART_ONE;
+    parts.y[i] = y * PART_ONE;
+    parts.vx[i] = vx;
+    parts.vy[i] = vy;
+    parts.life[i] = life;
+    parts.color[i] = color;
+}
+
+// n particles from (x, y): vx in [-spread, spread], vy in [-lift - spread, -lift]
+// (Q6 px/tick). color 0 gives each particle a random saturated hue.
+static void part_burst(int16_t x, int16_t y, uint8_t n, int16_t spread, int16_t lift,
+                       uint8_t life, uint16_t color) {
+    for (uint8_t k = 0; k < n; k++) {
+        int16_t vx = (int16_t)hlc_random_below(2 * spread + 1) - spread;
+        int16_t vy = -lift - (int16_t)hlc_random_below(spread + 1);
+        uint16_t c = color ? color : hlc_native_color(hlc_random_below(256), 255, 255);
+        part_emit(x, y, vx, vy, life + hlc_random_below(life / 2 + 1), c);
+    }
+}
+
+static void particles_update(void) {
+    uint32_t t0 = hlc_perf_now();
+    uint16_t n = parts.n;
+    for (uint16_t i = 0; i < n; i++) {
+        parts.vy[i] += PART_GRAVITY;
+        parts.x[i] += parts.vx[i];
+        parts.y[i] += parts.vy[i];
+        parts.life[i]--;
+    }
+    // Drop spent and off-area particles, keeping the live ones packed
+    uint16_t k = 0;
+    for (uint16_t i = 0; i < n; i++) {
+        if (!parts.life[i] || parts.x[i] < 0 || parts.x[i] > (SCR_W - PART_SIZE) * PART_ONE ||
+            parts.y[i] < GAME_Y * PART_ONE || parts.y[i] > (LVL_Y - PART_SIZE) * PART_ONE) continue;
+        parts.x[k] = parts.x[i];   parts.y[k] = parts.y[i];
+        parts.vx[k] = parts.vx[i]; parts.vy[k] = parts.vy[i];
+        parts.life[k] = parts.life[i];
+        parts.color[k] = parts.color[i];
+        k++;
+    }
+    parts.n = k;
+    hlc_perf_lap(PERF_PARTICLES, t0);
+}
+
+// Batch pass before compositing: row buckets and the cells covered this frame
+static void particles_bucket(void) {
+    memset(part_rows, 0, sizeof(part_rows));
+    memset(part_cells[1], 0, sizeof(part_cells[1]));
+    for (uint16_t i = 0; i < parts.n; i++) {
+        int16_t x = parts.x[i] >> PART_SHIFT;
+        int16_t y = (parts.y[i] >> PART_SHIFT) - GAME_Y;
+        parts.next[i] = part_rows[y];
+        part_rows[y] = i + 1;
+        uint32_t cols = (1u << (x >> CELL_SHIFT)) | (1u << ((x + PART_SIZE - 1) >> CELL_SHIFT));
+        part_cells[1][y >> CELL_SHIFT] |= cols;
+        part_cells[1][(y + PART_SIZE - 1) >> CELL_SHIFT] |= cols;
+    }
+}
+
+// Resolve the particles on scanline y into line[x0..x1]
+static void particles_span(int16_t y, uint16_t *line, int16_t x0, int16_t x1) {
+    for (int16_t r = y - PART_SIZE + 1; r <= y; r++) {
+        if (r < GAME_Y) continue;
+        for (uint16_t i = part_rows[r - GAME_Y]; i; i = parts.next[i - 1]) {
+            int16_t l = parts.x[i - 1] >> PART_SHIFT, rr = l + PART_SIZE - 1;
+            if (l < x0) l = x0;
+            if (rr > x1) rr = x1;
+            for (int16_t x = l; x <= rr; x++) line[x] = parts.color[i - 1];
+        }
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// COMPOSITOR — the game area is rebuilt one scanline at a time
+// Each frame lists every sprite in view, bottom layer first. Rectangles
+// where the list differs from the last frame are recomposed: per scanline,
+// each sprite's opaque spans are resolved in z-order into a line buffer,
+// and the result is written to the framebuffer exactly once.
+// ═══════════════════════════════════════════════════════════════════════
+
+enum {
+    SPR_CAT = 0,    // atlas frame, 2bpp palette, CAT_SCALE
+    SPR_MONO,       // 1bpp bitmap rows (icons, glyphs), one colour
+};
+
+typedef struct {
+    const void *bits;       // atlas_frame_t (SPR_CAT) or bitmap rows (SPR_MONO)
+    int16_t  x, y;          // on-screen origin
+    int16_t  top, bottom;   // on-screen rows actually covered
+    uint8_t  w;             // on-screen width
+    uint8_t  kind;
+    uint8_t  scale;
+    uint8_t  cols;          // SPR_MONO bitmap width, MSB is leftmost
+    bool     mirror;        // SPR_CAT only
+    uint16_t color;         // SPR_CAT: tier, SPR_MONO: native colour
+} sprite_t;
+
+#define SCENE_MAX   (MAX_ICONS + 6)     // orange + icons + 4 overlay glyphs + cat
+#define ROW_BANDS   3       // rects for a cat that only changed frame
+#define SCENE_RECTS (SCENE_MAX * ROW_BANDS)
+
+typedef struct {
+    uint8_t  n;
+    sprite_t spr[SCENE_MAX];
+} scene_t;
+
+static scene_t scenes[2];
+static uint8_t scene_cur = 0;   // index of the scene on screen
+
+static void scene_add_cat(scene_t *sc, int16_t x, int16_t y, const uint32_t *sprite,
+                          bool mirror, uint8_t tier) {
+    const atlas_frame_t *af = atlas_lookup(sprite);
+    if (!af || sc->n >= SCENE_MAX || x <= -CAT_W || x >= SCR_W) return;
+    sc->spr[sc->n++] = (sprite_t){
+        .bits = af, .x = x, .y = y,
+        .top = y + af->top * CAT_SCALE, .bottom = y + (af->bottom + 1) * CAT_SCALE - 1,
+        .w = CAT_W, .kind = SPR_CAT, .scale = CAT_SCALE, .mirror = mirror, .color = tier,
+    };
+}
+
+static void scene_add_mono(scene_t *sc, int16_t x, int16_t y, const uint8_t *rows,
+                           uint8_t cols, uint8_t nrows, uint8_t scale,
+                           uint8_t h, uint8_t s, uint8_t v) {
+    if (sc->n >= SCENE_MAX) return;
+    sc->spr[sc->n++] = (sprite_t){
+        .bits = rows, .x = x, .y = y, .top = y, .bottom = y + nrows * scale - 1,
+        .w = cols * scale, .kind = SPR_MONO, .scale = scale, .cols = cols,
+        .color = hlc_native_color(h, s, v),
+    };
+}
+
+static bool sprite_eq(const sprite_t *a, const sprite_t *b) {
+    return a->bits == b->bits && a->x == b->x && a->y == b->y && a->kind == b->kind &&
+           a->scale == b->scale && a->mirror == b->mirror && a->color == b->color;
+}
+
+// Sprite bounds clipped to the game area; false if nothing is visible
+static bool sprite_rect(const sprite_t *sp, hlc_rect_t *r) {
+    r->left   = sp->x < 0 ? 0 : sp->x;
+    r->right  = sp->x + sp->w - 1 >= SCR_W ? SCR_W - 1 : sp->x + sp->w - 1;
+    r->top    = sp->top < GAME_Y ? GAME_Y : sp->top;
+    r->bottom = sp->bottom >= LVL_Y ? LVL_Y - 1 : sp->bottom;
+    return r->left <= r->right && r->top <= r->bottom;
+}
+
+// Resolve one sprite's opaque pixels on scanline y into line[x0..x1]
+static void sprite_span(const sprite_t *sp, int16_t y, uint16_t *line, int16_t x0, int16_t x1) {
+    int row = (y - sp->y) / sp->scale;
+    if (sp->kind == SPR_CAT) {
+        const atlas_frame_t *af = sp->bits;
+        const atlas_row_t *ar = &af->rows[row];
+        const uint16_t *colors = tier_colors[sp->color];
+        uint32_t bits = af->bits[row];
+        for (int s = 0; s < ar->n; s++) {
+            for (int col = ar->start[s]; col < ar->start[s] + ar->len[s]; col++) {
+                uint16_t c = colors[(bits >> (2 * (CAT_BMP_W - 1 - col))) & 3];
+                int16_t px = sp->x + (sp->mirror ? CAT_BMP_W - 1 - col : col) * CAT_SCALE;
+                for (int16_t x = px; x < px + CAT_SCALE; x++)
+                    if (x >= x0 && x <= x1) line[x] = c;
+            }
+        }
+    } else {
+        uint8_t bits = ((const uint8_t *)sp->bits)[row];
+        for (int col = 0; bits && col < sp->cols; col++) {
+            if (!(bits & (1 << (sp->cols - 1 - col)))) continue;
+            int16_t px = sp->x + col * sp->scale;
+            int16_t l = px < x0 ? x0 : px;
+            int16_t r = px + sp->scale - 1 > x1 ? x1 : px + sp->scale - 1;
+            for (int16_t x = l; x <= r; x++) line[x] = sp->color;
+        }
+    }
+}
+
+// Recompose scanline y of rects[] from scene sc: the row is split into
+// disjoint x-intervals so no framebuffer pixel is written twice
+static void compose_line(const scene_t *sc, const hlc_rect_t *rects, uint8_t n, int16_t y) {
+    uint16_t *fb = (uint16_t *)lcd_surface_fb;
+    uint16_t line[SCR_W];
+
+    // Intervals covering this row, sorted by left edge
+    static int16_t l[SCENE_RECTS], r[SCENE_RECTS];
+    uint8_t k = 0;
+    for (uint8_t i = 0; i < n; i++) {
+        if (y < rects[i].top || y > rects[i].bottom) continue;
+        uint8_t j = k++;
+        for (; j > 0 && l[j - 1] > rects[i].left; j--) { l[j] = l[j - 1]; r[j] = r[j - 1]; }
+        l[j] = rects[i].left;
+        r[j] = rects[i].right;
+    }
+
+    for (uint8_t i = 0; i < k; i++) {
+        int16_t x0 = l[i], x1 = r[i];
+        while (i + 1 < k && l[i + 1] <= x1 + 1) {
+            if (r[i + 1] > x1) x1 = r[i + 1];
+            i++;
+        }
+        memset(&line[x0], 0, (x1 - x0 + 1) * sizeof(uint16_t));  // background
+        for (uint8_t s = 0; s < sc->n; s++) {
+            const sprite_t *sp = &sc->spr[s];
+            if (y < sp->top || y > sp->bottom || sp->x > x1 || sp->x + sp->w <= x0) continue;
+            sprite_span(sp, y, line, x0, x1);
+        }
+        if (parts.n) particles_span(y, line, x0, x1);
+        memcpy(&fb[y * SCR_W + x0], &line[x0], (x1 - x0 + 1) * sizeof(uint16_t));
+    }
+}
+
+// ─── Compose queue ───
+// Rects to recompose are queued in batches (the scene diff, then one per
+// particle cell row) and worked off a scanline at a time, so compositing
+// can stop at the end of a pass's slice and resume in the next. The scene
+// and particle buckets must hold still until the queue is empty.
+#define COMPOSE_BATCHES (1 + CELL_ROWS)
+#define COMPOSE_RECTS   (SCENE_RECTS + CELL_ROWS * ((CELL_COLS + 1) / 2))
+
+typedef struct {
+    uint16_t first;                 // into compose_q.rects
+    uint8_t  n;
+    int16_t  top, bottom;           // scanlines the batch spans
+} compose_batch_t;
+
+static struct {
+    hlc_rect_t      rects[COMPOSE_RECTS];
+    compose_batch_t batch[COMPOSE_BATCHES];
+    uint16_t n_rects;
+    uint8_t  n_batch;
+    uint8_t  cur;                   // batch being composed
+    int16_t  y;                     // its next scanline
+} compose_q;
+
+static void compose_queue(const hlc_rect_t *rects, uint8_t n) {
+    if (!n) return;
+    int16_t top = LVL_Y, bottom = GAME_Y - 1;
+    for (uint8_t i = 0; i < n; i++) {
+        if (rects[i].top < top) top = rects[i].top;
+        if (rects[i].bottom > bottom) bottom = rects[i].bottom;
+        hlc_damage_add(rects[i].left, rects[i].top, rects[i].right, rects[i].bottom);
+    }
+    if (!compose_q.n_batch) compose_q.y = top;
+    memcpy(&compose_q.rects[compose_q.n_rects], rects, n * sizeof(hlc_rect_t));
+    compose_q.batch[compose_q.n_batch++] = (compose_batch_t){compose_q.n_rects, n, top, bottom};
+    compose_q.n_rects += n;
+}
+
+// Compose queued scanlines from sc until the queue is empty (true) or the
+// slice is spent. At least one line is composed per call.
+static bool compose_run(const scene_t *sc) {
+    while (compose_q.cur < compose_q.n_batch) {
+        const compose_batch_t *b = &compose_q.batch[compose_q.cur];
+        compose_line(sc, &compose_q.rects[b->first], b->n, compose_q.y);
+        if (++compose_q.y > b->bottom && ++compose_q.cur < compose_q.n_batch)
+            compose_q.y = compose_q.batch[compose_q.cur].top;
+        if (compose_q.cur < compose_q.n_batch && slice_over()) return false;
+    }
+    compose_q.n_rects = compose_q.n_batch = compose_q.cur = 0;
+    return true;
+}
+
+// A cat that changed frame in place, to or from the next frame of its
+// animation: *rows gets the sprite rows the two frames differ in
+static bool cat_row_delta(const sprite_t *a, const sprite_t *b, uint16_t *rows) {
+    if (a->kind != SPR_CAT || b->kind != SPR_CAT || a->x != b->x || a->y != b->y ||
+        a->mirror != b->mirror || a->color != b->color) return false;
+    const atlas_frame_t *fa = a->bits, *fb = b->bits;
+    if (&atlas[fa->next] == fb) *rows = fa->delta;
+    else if (&atlas[fb->next] == fa) *rows = fb->delta;
+    else return false;
+    return true;
+}
+
+// Runs of changed rows as rects, at most ROW_BANDS; more runs than that
+// collapse into one band from the first to the last changed row
+static uint8_t cat_row_bands(const sprite_t *sp, uint16_t rows, hlc_rect_t *out) {
+    hlc_rect_t r;
+    if (!rows || !sprite_rect(sp, &r)) return 0;
+    uint8_t n = 0;
+    int first = -1, last = 0;
+    for (int row = 0; row <= CAT_BMP_H; row++) {
+        bool on = row < CAT_BMP_H && (rows & (1 << row));
+        if (on && first < 0) first = row;
+        if (on) last = row;
+        if (on || first < 0 || (row < CAT_BMP_H && n == ROW_BANDS - 1)) continue;
+        int16_t top = sp->y + first * CAT_SCALE, bottom = sp->y + (last + 1) * CAT_SCALE - 1;
+        if (top < GAME_Y) top = GAME_Y;             // not r: the old frame may
+        if (bottom >= LVL_Y) bottom = LVL_Y - 1;    // reach rows the new one doesn't
+        if (top <= bottom) out[n++] = (hlc_rect_t){r.left, top, r.right, bottom};
+        first = -1;
+    }
+    return n;
+}
+
+// Whether sc holds a sprite equal to sp. Scenes list sprites in a stable
+// order, so the same index is tried before the full scan.
+static bool scene_has(const scene_t *sc, const sprite_t *sp, uint8_t hint) {
+    if (hint < sc->n && sprite_eq(&sc->spr[hint], sp)) return true;
+    for (uint8_t i = 0; i < sc->n; i++)
+        if (sprite_eq(&sc->spr[i], sp)) return true;
+    return false;
+}
+
+// Show scene next: queue a recompose wherever it differs from the one on screen.
+// A cat that only stepped its animation redraws just the rows that changed.
+static void scene_present(const scene_t *next, const scene_t *prev) {
+    static hlc_rect_t rects[SCENE_RECTS];
+    bool done[SCENE_MAX];               // next sprites already accounted for
+    uint8_t n = 0;
+    for (uint8_t j = 0; j < next->n; j++) done[j] = scene_has(prev, &next->spr[j], j);
+    for (uint8_t i = 0; i < prev->n; i++) {
+        if (scene_has(next, &prev->spr[i], i)) continue;
+        uint16_t rows = 0;
+        uint8_t j = 0;
+        while (j < next->n && (done[j] || !cat_row_delta(&prev->spr[i], &next->spr[j], &rows))) j++;
+        if (j < next->n) {
+            done[j] = true;
+            n += cat_row_bands(&next->spr[j], rows, &rects[n]);
+        } else if (sprite_rect(&prev->spr[i], &rects[n])) {
+            n++;
+        }
     }
+    for (uint8_t j = 0; j < next->n; j++)
+        if (!done[j] && sprite_rect(&next->spr[j], &rects[n])) n++;
+    compose_queue(rects, n);
 }
 
-static void draw_zzz(int16_t cx, int16_t cy, uint16_t frame) {
+// Queue every cell particles covered on screen or cover in this frame
+static void particles_present(void) {
+    for (int row = 0; row < CELL_ROWS; row++) {
+        uint32_t m = part_cells[0][row] | part_cells[1][row];
+        part_cells[0][row] = part_cells[1][row];
+        hlc_rect_t rects[(CELL_COLS + 1) / 2];
+        uint8_t n = 0;
+        for (int c = 0; m >> c;) {
+            if (!((m >> c) & 1)) { c++; continue; }
+            int e = c;
+            while ((m >> e) & 1) e++;
+            int16_t right = (e << CELL_SHIFT) - 1;
+            rects[n++] = (hlc_rect_t){
+                c << CELL_SHIFT, GAME_Y + (row << CELL_SHIFT),
+                right < SCR_W ? right : SCR_W - 1, GAME_Y + ((row + 1) << CELL_SHIFT) - 1,
+            };
+            c = e;
+        }
+        compose_queue(rects, n);
+    }
+}
+
+// ─── Overlays ───
+static void scene_add_zzz(scene_t *sc, int16_t cx, int16_t cy, uint16_t frame) {
     // Three z's floating above sleeping cat, staggered
     int bob = (frame / 3) % 6;  // 0-5 cycle
     int offsets[3] = { bob, (bob + 2) % 6, (bob + 4) % 6 };
@@ -524,25 +1403,116 @@ static void draw_zzz(int16_t cx, int16_t cy, uint16_t frame) {
         int16_t zx = cx + CAT_W / 2 - 4 + i * 8;
         int16_t zy = cy - 8 - offsets[i];
         if (zy >= GAME_Y)
-            draw_glyph(zx, zy, glyph_z, 2, 0, 0, 180);
+            scene_add_mono(sc, zx, zy, glyph_z, 3, 5, 2, 0, 0, 180);
     }
 }
 
-static void draw_question(int16_t cx, int16_t cy, uint16_t frame) {
+static void scene_add_question(scene_t *sc, int16_t cx, int16_t cy, uint16_t frame) {
     int bob = ((frame / 4) % 3);  // 0,1,2 gentle bob
     int16_t qx = cx + CAT_W / 2 - 3;
     int16_t qy = cy - 12 - bob;
     if (qy >= GAME_Y)
-        draw_glyph(qx, qy, glyph_q, 2, 0, 0, 200);
+        scene_add_mono(sc, qx, qy, glyph_q, 3, 5, 2, 0, 0, 200);
 }
 
-static void draw_dead_text(void) {
+static void scene_add_dead_text(scene_t *sc) {
     const int16_t sx = (SCR_W - 45) / 2;
     const int16_t sy = SCR_H / 2 + 20;
-    draw_glyph(sx,      sy, glyph_d, 3, 0, 255, 220);
-    draw_glyph(sx + 12, sy, glyph_e, 3, 0, 255, 220);
-    draw_glyph(sx + 24, sy, glyph_a, 3, 0, 255, 220);
-    draw_glyph(sx + 36, sy, glyph_d, 3, 0, 255, 220);
+    static const uint8_t *const letters[4] = {glyph_d, glyph_e, glyph_a, glyph_d};
+    for (int i = 0; i < 4; i++)
+        scene_add_mono(sc, sx + i * 12, sy, letters[i], 3, 5, 3, 0, 255, 220);
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// KEY EVENTS — keypresses drive the game, not the smoothed WPM
+// process_record_user stamps each press into a single-producer/single-
+// consumer ring: O(1), no locks, no allocation. The game drains it once
+// per tick. When the tamagotchi is on the other half, the master counts
+// presses and sends them over a split transaction; the target's handler
+// is then the producer.
+// ═══════════════════════════════════════════════════════════════════════
+
+#define KEY_RING        32      // power of two; a tick drains it long before
+#define KEY_SYNC_MS     20      // master → target batching interval
+
+static struct {
+    uint32_t time[KEY_RING];
+    uint8_t  head;              // written by the producer only
+    uint8_t  tail;              // written by the consumer only
+    uint8_t  dropped;           // presses lost to a full ring, producer only
+} keys;
+static uint8_t keys_dropped_seen = 0;
+
+static bool tama_here(void) {
+#ifdef TAMAGOTCHI_ON_RIGHT
+    return !is_keyboard_left();
+#else
+    return is_keyboard_left();
+#endif
+}
+
+static void key_push(uint32_t time) {
+    uint8_t h = keys.head;
+    if ((uint8_t)(h - __atomic_load_n(&keys.tail, __ATOMIC_ACQUIRE)) == KEY_RING) {
+        __atomic_store_n(&keys.dropped, keys.dropped + 1, __ATOMIC_RELEASE);
+        return;
+    }
+    keys.time[h % KEY_RING] = time;
+    __atomic_store_n(&keys.head, (uint8_t)(h + 1), __ATOMIC_RELEASE);
+}
+
+// Presses since the last call; *last gets the newest one's time. A press
+// dropped on overflow still counts, stamped with the newest time seen.
+static uint8_t key_drain(uint32_t *last) {
+    uint8_t h = __atomic_load_n(&keys.head, __ATOMIC_ACQUIRE);
+    uint8_t n = h - keys.tail;
+    if (n) *last = keys.time[(uint8_t)(h - 1) % KEY_RING];
+    __atomic_store_n(&keys.tail, h, __ATOMIC_RELEASE);
+    uint8_t dropped = __atomic_load_n(&keys.dropped, __ATOMIC_ACQUIRE);
+    n += (uint8_t)(dropped - keys_dropped_seen);
+    keys_dropped_seen = dropped;
+    return n;
+}
+
+#ifdef SPLIT_KEYBOARD
+static uint8_t  key_sync_pending = 0;   // presses the target half has not been sent
+static uint32_t key_sync_time = 0;
+
+static void key_sync_handler(uint8_t in_len, const void *in, uint8_t out_len, void *out) {
+    if (in_len != 1) return;
+    uint32_t now = tama_now();
+    for (uint8_t n = *(const uint8_t *)in; n; n--) key_push(now);
+}
+
+void keyboard_post_init_user(void) {
+    transaction_register_rpc(TAMA_KEY_SYNC, key_sync_handler);
+}
+
+void housekeeping_task_user(void) {
+    if (!key_sync_pending || tama_elapsed(key_sync_time) < KEY_SYNC_MS) return;
+    uint8_t n = key_sync_pending;
+    if (transaction_rpc_send(TAMA_KEY_SYNC, 1, &n)) key_sync_pending -= n;
+    key_sync_time = tama_now();
+}
+#endif
+
+// Runs on the master for every key of both halves. Straight-line: a press
+// is an estimated 47 Cortex-M0+ cycles here, counted from the instruction
+// timings, plus is_keyboard_left() and tama_now(). sim/bench_keyhook
+// measures the whole hook at 3.7-3.8 ns a press on an x86-64 host.
+bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    if (!record->event.pressed) return true;
+    uint32_t t0 = hlc_perf_now();
+    if (tama_here()) {
+        key_push(tama_now());
+    }
+#ifdef SPLIT_KEYBOARD
+    else if (key_sync_pending < 255) {
+        key_sync_pending++;
+    }
+#endif
+    hlc_perf_lap(PERF_KEYHOOK, t0);
+    return true;
 }
 
 // ═══════════════════════════════════════════════════════════════════════
@@ -550,62 +1520,131 @@ static void draw_dead_text(void) {
 // ═══════════════════════════════════════════════════════════════════════
 
 static void pick_new_target(void) {
-    st.target_x = rand() % (SCR_W - CAT_W);
-    st.target_y = GAME_Y + rand() % (GAME_H - CAT_H);
+    st.target_x = hlc_random_below(SCR_W - CAT_W);
+    st.target_y = GAME_Y + hlc_random_below(GAME_H - CAT_H);
 }
 
-static void spawn_icon(void) {
+// ─── Icon pool ───
+// Free slots are a stack, so a spawn is O(1). After each move the live
+// icons are hashed into a uniform grid over the game area, and the pounce
+// search and eat check only visit the cells around the cat, however many
+// icons are out.
+#define ICON_CELL       32
+#define ICON_GRID_COLS  ((SCR_W + ICON_CELL - 1) / ICON_CELL)     // 5
+#define ICON_GRID_ROWS  ((GAME_H + ICON_CELL - 1) / ICON_CELL)    // 6
+
+static uint8_t icon_free[MAX_ICONS];
+static uint8_t icon_free_n = 0;
+static uint8_t icon_grid[ICON_GRID_ROWS][ICON_GRID_COLS];   // first icon, index + 1
+static uint8_t icon_next[MAX_ICONS];                         // chain within a cell
+
+static int icon_grid_col(int16_t x) {
+    int c = x / ICON_CELL;
+    return c < 0 ? 0 : c >= ICON_GRID_COLS ? ICON_GRID_COLS - 1 : c;
+}
+
+static int icon_grid_row(int16_t y) {
+    int r = (y - GAME_Y) / ICON_CELL;
+    return r < 0 ? 0 : r >= ICON_GRID_ROWS ? ICON_GRID_ROWS - 1 : r;
+}
+
+// Grid cell of every live icon, keyed by its top-left corner
+static void icon_grid_build(void) {
+    memset(icon_grid, 0, sizeof(icon_grid));
     for (int i = 0; i < MAX_ICONS; i++) {
-        if (st.icons[i].active) continue;
-        st.icons[i].active = true;
-        st.icons[i].type = st.next_icon_type;
-        st.next_icon_type = (st.next_icon_type + 1) % 3;
-        int edge = rand() % 4;
-        switch (edge) {
-            case 0:
-                st.icons[i].x = rand() % (SCR_W - ICON_W);
-                st.icons[i].y = GAME_Y;
-                break;
-            case 1:
-                st.icons[i].x = rand() % (SCR_W - ICON_W);
-                st.icons[i].y = GAME_Y + GAME_H - ICON_H;
-                break;
-            case 2:
-                st.icons[i].x = 0;
-                st.icons[i].y = GAME_Y + rand() % (GAME_H - ICON_H);
-                break;
-            default:
-                st.icons[i].x = SCR_W - ICON_W;
-                st.icons[i].y = GAME_Y + rand() % (GAME_H - ICON_H);
-                break;
-        }
-        int16_t ddx = (st.cat_x + CAT_W/2) - (st.icons[i].x + ICON_W/2);
-        int16_t ddy = (st.cat_y + CAT_H/2) - (st.icons[i].y + ICON_H/2);
-        st.icons[i].dx = (ddx > 0) ? 1 : ((ddx < 0) ? -1 : 0);
-        st.icons[i].dy = (ddy > 0) ? 1 : ((ddy < 0) ? -1 : 0);
-        if (!st.icons[i].dx && !st.icons[i].dy) st.icons[i].dy = -1;
-        return;
+        if (!st.icons[i].active) continue;
+        uint8_t *head = &icon_grid[icon_grid_row(st.icons[i].y)][icon_grid_col(st.icons[i].x)];
+        icon_next[i] = *head;
+        *head = i + 1;
+    }
+}
+
+// Free stack and grid from the active flags, after init or a restore.
+// Lowest slots are handed out first.
+static void icons_reindex(void) {
+    icon_free_n = 0;
+    for (int i = MAX_ICONS - 1; i >= 0; i--)
+        if (!st.icons[i].active) icon_free[icon_free_n++] = i;
+    icon_grid_build();
+}
+
+static void icon_release(int i) {
+    st.icons[i].active = false;
+    icon_free[icon_free_n++] = i;
+}
+
+// Live icons whose top-left corner may lie in [x0, x1] x [y0, y1]: every
+// icon in the grid cells the box touches. Callers apply the exact test.
+static uint8_t icons_near(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t *out) {
+    uint8_t n = 0;
+    for (int r = icon_grid_row(y0); r <= icon_grid_row(y1); r++)
+        for (int c = icon_grid_col(x0); c <= icon_grid_col(x1); c++)
+            for (uint8_t i = icon_grid[r][c]; i; i = icon_next[i - 1])
+                if (st.icons[i - 1].active) out[n++] = i - 1;
+    return n;
+}
+
+static void spawn_icon(void) {
+    if (!icon_free_n) return;
+    int i = icon_free[--icon_free_n];
+    st.icons[i].active = true;
+    st.icons[i].type = st.next_icon_type;
+    st.next_icon_type = (st.next_icon_type + 1) % 3;
+    int edge = hlc_random_below(4);
+    switch (edge) {
+        case 0:
+            st.icons[i].x = hlc_random_below(SCR_W - ICON_W);
+            st.icons[i].y = GAME_Y;
+            break;
+        case 1:
+            st.icons[i].x = hlc_random_below(SCR_W - ICON_W);
+            st.icons[i].y = GAME_Y + GAME_H - ICON_H;
+            break;
+        case 2:
+            st.icons[i].x = 0;
+            st.icons[i].y = GAME_Y + hlc_random_below(GAME_H - ICON_H);
+            break;
+        default:
+            st.icons[i].x = SCR_W - ICON_W;
+            st.icons[i].y = GAME_Y + hlc_random_below(GAME_H - ICON_H);
+            break;
     }
+    int16_t ddx = (st.cat_x + CAT_W/2) - (st.icons[i].x + ICON_W/2);
+    int16_t ddy = (st.cat_y + CAT_H/2) - (st.icons[i].y + ICON_H/2);
+    st.icons[i].dx = (ddx > 0) ? 1 : ((ddx < 0) ? -1 : 0);
+    st.icons[i].dy = (ddy > 0) ? 1 : ((ddy < 0) ? -1 : 0);
+    if (!st.icons[i].dx && !st.icons[i].dy) st.icons[i].dy = -1;
 }
 
+// Icons step toward the cat; the grid is rebuilt, then the cells around
+// the cat are checked for icons close enough to eat
 static void update_icons(void) {
     int16_t cat_cx = st.cat_x + CAT_W / 2;
     int16_t cat_cy = st.cat_y + CAT_H / 2;
 
     for (int i = 0; i < MAX_ICONS; i++) {
         if (!st.icons[i].active) continue;
-        int16_t icx = st.icons[i].x + ICON_W / 2;
-        int16_t icy = st.icons[i].y + ICON_H / 2;
-        int16_t ddx = cat_cx - icx;
-        int16_t ddy = cat_cy - icy;
+        int16_t ddx = cat_cx - (st.icons[i].x + ICON_W / 2);
+        int16_t ddy = cat_cy - (st.icons[i].y + ICON_H / 2);
         st.icons[i].dx = (ddx > 0) ? MOVE_SPEED : ((ddx < 0) ? -MOVE_SPEED : 0);
         st.icons[i].dy = (ddy > 0) ? MOVE_SPEED : ((ddy < 0) ? -MOVE_SPEED : 0);
         st.icons[i].x += st.icons[i].dx;
         st.icons[i].y += st.icons[i].dy;
+    }
+    icon_grid_build();
 
+    uint8_t near[MAX_ICONS];
+    uint8_t n = icons_near(cat_cx - ICON_W / 2 - 15, cat_cy - ICON_H / 2 - 15,
+                           cat_cx - ICON_W / 2 + 15, cat_cy - ICON_H / 2 + 15, near);
+    for (uint8_t k = 0; k < n; k++) {
+        int i = near[k];
         if (abs(cat_cx - (st.icons[i].x + ICON_W/2)) < 16 &&
             abs(cat_cy - (st.icons[i].y + ICON_H/2)) < 16) {
-            st.icons[i].active = false;
+            icon_release(i);
+            uint8_t t = st.icons[i].type;
+            part_burst(st.icons[i].x + ICON_W / 2, st.icons[i].y + ICON_H / 2, 10,
+                       PART_ONE, PART_ONE, 5,
+                       hlc_native_color(icon_colors[t][0], icon_colors[t][1], icon_colors[t][2]));
             if (st.health <= MAX_HEALTH - ICON_HP_GAIN)
                 st.health += ICON_HP_GAIN;
             else
@@ -615,36 +1654,28 @@ static void update_icons(void) {
     }
 }
 
-static void get_spawn_interval(uint8_t wpm, uint16_t *min_ms, uint16_t *range_ms) {
-    if (wpm <= 20)      { *min_ms = 8000; *range_ms = 4000; }
-    else if (wpm <= 50) { *min_ms = 4000; *range_ms = 4000; }
-    else if (wpm <= 80) { *min_ms = 2000; *range_ms = 2000; }
-    else                { *min_ms = 1000; *range_ms = 1000; }
-}
-
 // ─── Orange cat encounter logic ───
 static void update_orange(uint32_t now) {
     if (st.is_dead) return;  // no encounter while dead
 
     if (st.orange_phase == ORANGE_NONE) {
         // Check for spawn
-        if (timer_elapsed32(st.last_orange_check) >= ORANGE_CHECK_MS) {
+        if (tama_elapsed(st.last_orange_check) >= ORANGE_CHECK_MS) {
             st.last_orange_check = now;
-            if ((rand() % 100) < ORANGE_SPAWN_PCT) {
+            if (hlc_random_below(100) < ORANGE_SPAWN_PCT) {
                 // Start encounter — pick entry side
-                bool from_left = (rand() % 2) == 0;
-                st.orange_y = GAME_Y + 20 + rand() % (GAME_H - CAT_H - 40);
+                bool from_left = hlc_random_below(2) == 0;
+                st.orange_y = GAME_Y + 20 + hlc_random_below(GAME_H - CAT_H - 40);
                 if (from_left) {
                     st.orange_x = -CAT_W;
-                    st.orange_target_x = 10 + rand() % 30;
+                    st.orange_target_x = 10 + hlc_random_below(30);
                     st.orange_facing_left = false;
                 } else {
                     st.orange_x = SCR_W;
-                    st.orange_target_x = SCR_W - CAT_W - 10 - rand() % 30;
+                    st.orange_target_x = SCR_W - CAT_W - 10 - hlc_random_below(30);
                     st.orange_facing_left = true;
                 }
                 st.orange_frame = 0;
-                st.prev_orange_drawn = false;
                 st.orange_phase = ORANGE_ENTER;
                 st.orange_phase_timer = now;
             }
@@ -670,7 +1701,7 @@ static void update_orange(uint32_t now) {
         case ORANGE_IDLE:
             // Pause, face the main cat
             st.orange_facing_left = (st.cat_x < st.orange_x);
-            if (timer_elapsed32(st.orange_phase_timer) >= ORANGE_IDLE_MS) {
+            if (tama_elapsed(st.orange_phase_timer) >= ORANGE_IDLE_MS) {
                 st.orange_phase = ORANGE_MAD;
                 st.orange_phase_timer = now;
                 st.orange_frame = 0;  // restart angry anim
@@ -678,7 +1709,7 @@ static void update_orange(uint32_t now) {
             break;
         case ORANGE_MAD:
             // Main cat gets angry, faces orange cat
-            if (timer_elapsed32(st.orange_phase_timer) >= ORANGE_MAD_MS) {
+            if (tama_elapsed(st.orange_phase_timer) >= ORANGE_MAD_MS) {
                 st.orange_phase = ORANGE_CHASE;
                 st.orange_phase_timer = now;
             }
@@ -689,9 +1720,12 @@ static void update_orange(uint32_t now) {
             int speed = MOVE_SPEED + 2;
             if (exit_x > st.orange_x)      { st.orange_x += speed; st.orange_facing_left = false; }
             else if (exit_x < st.orange_x) { st.orange_x -= speed; st.orange_facing_left = true; }
+            // Dust kicked up behind the fleeing cat
+            int16_t heel = st.orange_facing_left ? st.orange_x + CAT_W - 12 : st.orange_x + 12;
+            part_burst(heel, st.orange_y + CAT_H - 4, 2, PART_ONE / 2, PART_ONE / 2, 4,
+                       hlc_native_color(24, 60, 110));
             if (st.orange_x <= -CAT_W || st.orange_x >= SCR_W) {
                 st.orange_phase = ORANGE_NONE;
-                st.prev_orange_drawn = false;
                 pick_new_target();
             }
             break;
@@ -700,12 +1734,16 @@ static void update_orange(uint32_t now) {
 }
 
 static void update_game(void) {
-    st.cur_wpm = get_current_wpm();
-    uint8_t wpm = st.cur_wpm;
-    uint32_t now = timer_read32();
+    interp_begin_tick();
+    particles_update();
+    uint32_t now = tama_now();
+
+    // Presses since the last tick
+    uint8_t presses = key_drain(&st.last_active);
+    bool typing = tama_elapsed(st.last_active) < TYPING_MS;
 
     // Health drain
-    if (timer_elapsed32(st.last_drain) >= DRAIN_MS) {
+    if (tama_elapsed(st.last_drain) >= DRAIN_MS) {
         st.last_drain = now;
         if (st.health > 0) {
             st.health--;
@@ -713,25 +1751,22 @@ static void update_game(void) {
         }
     }
 
-    // Track typing activity
-    if (wpm > 0) st.last_active = now;
-
     // Revive on typing
-    if (wpm > 0 && st.is_dead) {
+    if (presses && st.is_dead) {
         st.is_dead = false;
         st.health = REVIVE_HEALTH;
         st.last_drain = now;
         pick_new_target();
     }
 
-    uint32_t idle_ms = timer_elapsed32(st.last_active);
+    uint32_t idle_ms = tama_elapsed(st.last_active);
 
     // Determine animation state
     if (st.is_dead) {
         st.anim_state = ANIM_DEAD;
-    } else if (wpm == 0 && idle_ms >= IDLE_SLEEP_MS) {
+    } else if (!typing && idle_ms >= IDLE_SLEEP_MS) {
         st.anim_state = ANIM_SLEEP;
-    } else if (wpm == 0 && idle_ms > 0) {
+    } else if (!typing) {
         st.anim_state = ANIM_SIT;
     } else {
         // Typing — walk toward target, idle when arrived
@@ -756,14 +1791,18 @@ static void update_game(void) {
     }
 
     // Movement — only in WALK/IDLE states
+    pouncing = false;
     if (st.anim_state == ANIM_WALK || st.anim_state == ANIM_IDLE) {
         // Check for nearby icon → pounce toward it
         int32_t best_dist = 9999;
         int best_ix = -1;
-        for (int i = 0; i < MAX_ICONS; i++) {
-            if (!st.icons[i].active) continue;
+        uint8_t near[MAX_ICONS];
+        uint8_t n = icons_near(st.cat_x - POUNCE_DIST + 1, st.cat_y - POUNCE_DIST + 1,
+                               st.cat_x + POUNCE_DIST - 1, st.cat_y + POUNCE_DIST - 1, near);
+        for (uint8_t k = 0; k < n; k++) {
+            int i = near[k];
             int32_t d = abs(st.cat_x - st.icons[i].x) + abs(st.cat_y - st.icons[i].y);
-            if (d < POUNCE_DIST && d < best_dist) {
+            if (d < POUNCE_DIST && (d < best_dist || (d == best_dist && i < best_ix))) {
                 best_dist = d;
                 best_ix = i;
             }
@@ -775,6 +1814,7 @@ static void update_game(void) {
             ty = st.icons[best_ix].y;
             speed = MOVE_SPEED + 1; // slightly faster pounce
             st.anim_state = ANIM_WALK;
+            pouncing = true;
         } else {
             tx = st.target_x;
             ty = st.target_y;
@@ -794,17 +1834,18 @@ static void update_game(void) {
         }
 
         // Low health: occasionally sit
-        if (st.health < 60 && (rand() % 8) == 0)
+        if (st.health < 60 && hlc_random_below(8) == 0)
             st.anim_state = ANIM_SIT;
     }
 
-    // Icon spawning
-    if (wpm > 0) {
-        uint16_t min_ms, range_ms;
-        get_spawn_interval(wpm, &min_ms, &range_ms);
-        if (timer_elapsed32(st.last_icon_spawn) >= (uint32_t)(min_ms + (rand() % range_ms))) {
+    // Icon spawning: every ICON_KEYS_MIN..+RANGE presses, so faster
+    // typing brings food faster
+    if (presses) {
+        st.keys_to_icon = st.keys_to_icon > presses ? st.keys_to_icon - presses : 0;
+        if (!st.keys_to_icon && tama_elapsed(st.last_icon_spawn) >= ICON_MIN_MS) {
             spawn_icon();
             st.last_icon_spawn = now;
+            st.keys_to_icon = ICON_KEYS_MIN + hlc_random_below(ICON_KEYS_RANGE);
         }
     }
 
@@ -812,9 +1853,9 @@ static void update_game(void) {
     if (st.bounce_timer > 0) st.bounce_timer--;
 
     // XP gain from typing
-    if (wpm > 0) {
+    if (presses) {
         uint16_t prev_level = st.level;
-        st.xp += wpm;
+        st.xp += presses * XP_PER_KEY;
         while (st.xp >= st.xp_next) {
             st.xp -= st.xp_next;
             st.level++;
@@ -822,237 +1863,435 @@ static void update_game(void) {
             st.xp_bar_div = st.xp_next / XP_BAR_W;
             if (st.xp_bar_div == 0) st.xp_bar_div = 1;
         }
-        if (st.level != prev_level) save_progress();
+        if (st.level != prev_level) {
+            part_burst(SCR_W / 2, LVL_Y - PART_SIZE, PART_LEVEL_UP, 3 * PART_ONE / 2, 4 * PART_ONE, 20, 0);
+            save_state();
+        }
     }
 
     st.frame++;
 }
 
 // ═══════════════════════════════════════════════════════════════════════
-// FRAME RENDERING — dirty-rect approach to minimize SPI transfer
+// FRAME RENDERING — damaged windows only, to minimize SPI transfer
+// The game area goes through the compositor; the top and level bars are
+// redrawn only when their values change. The flush streams the damage.
 // ═══════════════════════════════════════════════════════════════════════
 
-static void draw_frame(void) {
-    uint8_t wpm = st.cur_wpm;
-    uint8_t half_hearts = st.health / 10;
+// List everything in the game area, bottom layer first
+static void build_scene(scene_t *sc) {
+    const tama_state_t *s = lagging ? &shown : &st;
+    sc->n = 0;
 
     // ── Select animation frame ──
-    const uint32_t (*frames)[16];
-    uint8_t num_frames, anim_speed;
-    switch (st.anim_state) {
-        case ANIM_WALK:  frames = anim_trot;  num_frames = 8; anim_speed = 3; break;
-        case ANIM_FLEE:  frames = anim_trot;  num_frames = 8; anim_speed = 2; break;
-        case ANIM_SIT:   frames = anim_walk;  num_frames = 4; anim_speed = 12; break;
-        case ANIM_SLEEP: frames = anim_sleep; num_frames = 4; anim_speed = 8; break;
-        case ANIM_DEAD:  frames = anim_sleep; num_frames = 4; anim_speed = 8; break;
-        default:         frames = anim_sit;   num_frames = 4; anim_speed = 6; break;
-    }
-    if (st.orange_phase == ORANGE_MAD || st.orange_phase == ORANGE_CHASE) {
-        frames = anim_angry; num_frames = 8; anim_speed = 3;
-    }
-    int fi = (st.frame / anim_speed) % num_frames;
-    const uint32_t *sprite = frames[fi];
+    const anim_def_t *anim = orange_rival[s->orange_phase];
+    if (!anim) anim = &cat_anims[s->anim_state];
+    const uint32_t *sprite = anim_sprite(anim, s->frame);
 
-    // Cat brightness from health
-    uint8_t cat_bright;
-    if (st.is_dead)          cat_bright = 80;
-    else if (st.health < 30) cat_bright = 140;
-    else                     cat_bright = 255;
+    // Cat brightness tier from health
+    uint8_t cat_tier;
+    if (s->is_dead)          cat_tier = TIER_CAT_DEAD;
+    else if (s->health < 30) cat_tier = TIER_CAT_WEAK;
+    else                     cat_tier = TIER_CAT;
 
     // Bounce offset when eating
     int16_t bounce_y = 0;
-    if (st.bounce_timer > 0) {
+    if (s->bounce_timer > 0) {
         static const int8_t bounce_off[] = {-4, -6, -2};
-        bounce_y = bounce_off[3 - st.bounce_timer];
+        bounce_y = bounce_off[3 - s->bounce_timer];
     }
 
-    // ── Determine if cat sprite needs redrawing ──
-    int16_t render_y = st.cat_y + bounce_y;
-    bool cat_dirty = (sprite != st.prev_sprite ||
-                      st.cat_x != st.prev_cat_x ||
-                      render_y != st.prev_cat_y ||
-                      st.facing_left != st.prev_cat_facing ||
-                      cat_bright != st.prev_cat_bright);
-
-    // ── Determine if orange cat needs redrawing ──
-    const uint32_t *osprite = NULL;
-    bool orange_dirty = false;
-    if (st.orange_phase != ORANGE_NONE) {
-        const uint32_t (*oframes)[16];
-        uint8_t onum, ospeed;
-        if (st.orange_phase == ORANGE_CHASE) {
-            oframes = anim_trot; onum = 8; ospeed = 2;
-        } else if (st.orange_phase == ORANGE_MAD) {
-            oframes = anim_walk; onum = 4; ospeed = 8;
-        } else if (st.orange_phase == ORANGE_IDLE) {
-            oframes = anim_walk; onum = 4; ospeed = 10;
-        } else {
-            oframes = anim_trot; onum = 8; ospeed = 3;
-        }
-        int ofi = (st.orange_frame / ospeed) % onum;
-        osprite = oframes[ofi];
-        orange_dirty = (osprite != st.prev_orange_sprite ||
-                        st.orange_x != st.prev_orange_x ||
-                        st.orange_y != st.prev_orange_y ||
-                        st.orange_facing_left != st.prev_orange_facing);
+    int16_t cat_x = interp(s->cat_x, st.cat_x);
+    int16_t cat_y = interp(s->cat_y, st.cat_y);
+
+    // ── Layer 1 (bottom): Orange cat ──
+    if (s->orange_phase != ORANGE_NONE)
+        scene_add_cat(sc, interp(s->orange_x, st.orange_x),
+                      interp(s->orange_y, st.orange_y),
+                      anim_sprite(&orange_anims[s->orange_phase], s->orange_frame),
+                      s->orange_facing_left, TIER_ORANGE);
+
+    // ── Layer 2: Icons ──
+    for (int i = 0; i < MAX_ICONS; i++) {
+        if (!s->icons[i].active) continue;
+        uint8_t t = s->icons[i].type;
+        scene_add_mono(sc, interp(s->icons[i].x, st.icons[i].x),
+                       interp(s->icons[i].y, st.icons[i].y), icon_sprites[t],
+                       ICON_BMP_W, ICON_BMP_H, ICON_SCALE,
+                       icon_colors[t][0], icon_colors[t][1], icon_colors[t][2]);
     }
 
-    // Only force both cats to redraw when they're close enough that
-    // clear_rect of one could leave black holes in the other
-    if (st.orange_phase != ORANGE_NONE &&
-        abs(st.cat_x - st.orange_x) < CAT_W * 2 &&
-        abs(render_y - st.orange_y) < CAT_H * 2) {
-        cat_dirty = true;
-        orange_dirty = true;
+    // ── Layer 3: Overlays (zzz, ?, DEAD) ──
+    if (s->anim_state == ANIM_SLEEP)
+        scene_add_zzz(sc, cat_x, cat_y, s->frame);
+    else if (s->anim_state == ANIM_SIT)
+        scene_add_question(sc, cat_x, cat_y, s->frame);
+    else if (s->is_dead)
+        scene_add_dead_text(sc);
+
+    // ── Layer 4 (top): Main cat — always on top of everything ──
+    scene_add_cat(sc, cat_x, cat_y + bounce_y, sprite, s->facing_left, cat_tier);
+}
+
+// ─── Static scene: partial display ───
+// After QUIET_FRAMES slow frames the panel scans out only the rows that
+// hold sprites (cat, zzz, DEAD); the bars go dark but stay in GRAM and
+// come back with the first normal-rate frame. The band follows the zzz bob.
+// The mode is worked out with the frame and applied where it is flushed.
+enum { PANEL_KEEP, PANEL_NORMAL, PANEL_PARTIAL };
+
+static struct {
+    uint8_t mode;
+    int16_t top, bottom;
+} panel_req;
+
+static void update_panel_mode(void) {
+    panel_req.mode = PANEL_KEEP;
+    if (cur_frame_ticks == 1) {
+        if (quiet_frames >= QUIET_FRAMES) panel_req.mode = PANEL_NORMAL;
+        quiet_frames = 0;
+        return;
+    }
+    if (quiet_frames < QUIET_FRAMES && ++quiet_frames < QUIET_FRAMES) return;
+
+    const scene_t *sc = &scenes[scene_cur];
+    int16_t top = LVL_Y, bottom = GAME_Y - 1;
+    hlc_rect_t r;
+    for (int i = 0; i < sc->n; i++) {
+        if (!sprite_rect(&sc->spr[i], &r)) continue;
+        if (r.top < top) top = r.top;
+        if (r.bottom > bottom) bottom = r.bottom;
     }
+    if (top <= bottom) {
+        panel_req.mode = PANEL_PARTIAL;
+        panel_req.top = top;
+        panel_req.bottom = bottom;
+    }
+}
 
-    // ── Clear old positions ──
-    clear_rect(st.prev_cat_x, st.prev_cat_y - OVERLAY_PAD, CAT_W, OVERLAY_PAD);
-    if (cat_dirty)
-        clear_rect(st.prev_cat_x, st.prev_cat_y, CAT_W, CAT_H);
-    bool was_orange_drawn = st.prev_orange_drawn;
-    st.prev_orange_drawn = false;
-    if (was_orange_drawn && orange_dirty)
-        clear_rect(st.prev_orange_x, st.prev_orange_y, CAT_W, CAT_H);
-    else if (st.orange_phase == ORANGE_NONE && was_orange_drawn)
-        clear_rect(st.prev_orange_x, st.prev_orange_y, CAT_W, CAT_H);
-    for (int i = 0; i < MAX_ICONS; i++) {
-        if (st.icons[i].prev_drawn)
-            clear_rect(st.icons[i].prev_x, st.icons[i].prev_y, ICON_W, ICON_H);
+static void panel_apply(void) {
+    if (panel_req.mode == PANEL_NORMAL) hlc_panel_normal();
+    else if (panel_req.mode == PANEL_PARTIAL) hlc_panel_partial(panel_req.top, panel_req.bottom);
+}
+
+// ─── Frame handoff ───
+// On one core a finished frame goes straight to the flush. With
+// HLC_CORE1_ENABLE core0 owns SPI: core1 raises frame_ready and starts no
+// new frame until core0 has flushed the damage and cleared it.
+#ifdef HLC_CORE1_ENABLE
+static uint32_t frame_ready = 0;
+
+static void frame_out(void) {
+    __atomic_store_n(&frame_ready, 1, __ATOMIC_RELEASE);
+}
+
+static bool frame_pending(void) {
+    return __atomic_load_n(&frame_ready, __ATOMIC_ACQUIRE);
+}
+#else
+// The mode first: the panel is idle then, so switching it does not drain
+// the new batch outside the slice
+static void frame_out(void) {
+    panel_apply();
+    hlc_damage_flush();
+}
+
+// The panel has not taken the last frame yet
+static bool frame_pending(void) {
+    return hlc_flush_busy();
+}
+#endif
+
+// Advance the frame in progress through its stages until it is handed to
+// the flush or the slice is spent. Game state must not change while the
+// stage is FRAME_COMPOSE: the queue is composed from the scene as built.
+static void draw_stages(void) {
+    uint32_t perf_t = hlc_perf_now();
+
+    // ── Game area: rebuild the scene, queue where it changed ──
+    if (frame_stage == FRAME_SCENE) {
+        scene_t *next = &scenes[scene_cur ^ 1];
+        build_scene(next);
+        particles_bucket();
+        scene_present(next, &scenes[scene_cur]);
+        particles_present();
+        scene_cur ^= 1;
+        frame_stage = FRAME_COMPOSE;
+        perf_t = hlc_perf_lap(PERF_SCENE, perf_t);
+        if (slice_over()) return;
     }
-    if (st.prev_was_dead && !st.is_dead)
-        clear_rect((SCR_W - 45) / 2, SCR_H / 2 + 20, 48, 18);
-
-    // ── Top bar (WPM + hearts) ──
-    if (wpm != st.prev_wpm || half_hearts != st.prev_half_hearts) {
-        qp_rect(lcd_surface, 0, 0, SCR_W - 1, GAME_Y - 1, 0, 0, 0, true);
-        draw_wpm(wpm);
-        draw_hearts(half_hearts);
-        st.prev_wpm = wpm;
-        st.prev_half_hearts = half_hearts;
+
+    if (frame_stage == FRAME_COMPOSE) {
+        bool done = compose_run(&scenes[scene_cur]);
+        compose_us += hlc_perf_now() - perf_t;
+        perf_t = hlc_perf_now();
+        if (!done) return;
+        hlc_perf_record(PERF_COMPOSE, compose_us);
+        compose_us = 0;
+        frame_stage = FRAME_BARS;
+        if (slice_over()) return;
     }
 
-    // ── Level bar ──
-    uint8_t bar_fill = (uint8_t)(st.xp / st.xp_bar_div);
-    if (bar_fill > XP_BAR_W) bar_fill = XP_BAR_W;
-    if (st.level != st.prev_level || bar_fill != st.prev_bar_fill) {
-        draw_level_bar(st.level, bar_fill);
-        st.prev_level = st.level;
-        st.prev_bar_fill = bar_fill;
+    if (frame_stage == FRAME_BARS) {
+        // ── Top bar (WPM + hearts) ──
+#ifndef HLC_CORE1_ENABLE
+        in.wpm = get_current_wpm();
+#endif
+        uint8_t wpm = in.wpm;
+        uint8_t half_hearts = st.health / 10;
+        if (wpm != st.prev_wpm || half_hearts != st.prev_half_hearts) {
+            fill_rect(0, 0, SCR_W - 1, GAME_Y - 1, 0, 0, 0);
+            draw_wpm(wpm);
+            draw_hearts(half_hearts);
+            st.prev_wpm = wpm;
+            st.prev_half_hearts = half_hearts;
+        }
+        perf_t = hlc_perf_lap(PERF_TOPBAR, perf_t);
+
+        // ── Level bar ──
+        uint8_t bar_fill = (uint8_t)(st.xp / st.xp_bar_div);
+        if (bar_fill > XP_BAR_W) bar_fill = XP_BAR_W;
+        if (st.level != st.prev_level || bar_fill != st.prev_bar_fill) {
+            draw_level_bar(st.level, bar_fill);
+            st.prev_level = st.level;
+            st.prev_bar_fill = bar_fill;
+        }
+        perf_t = hlc_perf_lap(PERF_LVLBAR, perf_t);
+        frame_stage = FRAME_FLUSH;
+        if (slice_over()) return;
     }
 
-    // ── Layer 1 (bottom): Orange cat ──
-    if (st.orange_phase != ORANGE_NONE && st.orange_x > -CAT_W && st.orange_x < SCR_W) {
-        if (orange_dirty) {
-            draw_cat(st.orange_x, st.orange_y, osprite,
-                     st.orange_facing_left, 255, orange_palette);
-            st.prev_orange_x = st.orange_x;
-            st.prev_orange_y = st.orange_y;
-            st.prev_orange_sprite = osprite;
-            st.prev_orange_facing = st.orange_facing_left;
+    // ── Single flush: only the damaged windows go out over SPI, in
+    // slices on later passes if the batch is large ──
+    update_panel_mode();
+    frame_out();
+    hlc_perf_lap(PERF_FLUSH, perf_t);
+    frame_stage = FRAME_IDLE;
+}
+
+// One pass of drawing
+static void draw_step(void) {
+    uint32_t t0 = hlc_perf_now();
+    draw_stages();
+    frame_us += hlc_perf_now() - t0;
+    if (frame_stage != FRAME_IDLE) return;
+    hlc_perf_record(PERF_FRAME, frame_us);
+    frame_us = 0;
+}
+
+// ─── Frame scheduler ───
+static bool icons_active(void) {
+    return icon_free_n < MAX_ICONS;
+}
+
+// Game ticks per frame for the current state. A cat in an ANIM_QUIET
+// animation (sleeping, dead) with nothing else on screen only changes with
+// the slow z-bob, so it is drawn at a fraction of the tick rate.
+static uint8_t frame_ticks(void) {
+    bool quiet = cat_anims[st.anim_state].hints & ANIM_QUIET;
+    if (quiet && st.orange_phase == ORANGE_NONE && st.bounce_timer == 0 &&
+        !icons_active() && !parts.n) return SLOW_TICKS;
+    return 1;
+}
+
+// Fast motion worth frames between ticks: the orange cat running in or
+// out, or the cat pouncing on an icon
+static bool frame_fast(void) {
+    return st.orange_phase == ORANGE_ENTER || st.orange_phase == ORANGE_CHASE || pouncing;
+}
+
+// One pass: due game ticks, then as much of the current frame as fits in
+// what is left of the slice. A housekeeping pass, or a core1 loop pass.
+static void tama_pass(void) {
+    // Auto-save XP progress every 5 minutes
+    if (tama_elapsed(last_save_time) >= SAVE_INTERVAL) {
+        save_state();
+        last_save_time = tama_now();
+    }
+
+    uint32_t now = tama_now();
+
+    // Game time advances in fixed ticks whatever the frame rate, so a
+    // late, skipped or slower frame does not change gameplay. Past
+    // MAX_CATCHUP the backlog is dropped rather than run in a burst. Ticks
+    // wait while a frame is being composed, and stop at the end of the slice.
+    uint32_t ticks = (now - tick_time) / TICK_MS;
+    if (ticks && frame_stage != FRAME_COMPOSE) {
+        if (ticks > MAX_CATCHUP) {
+            tick_time += (ticks - MAX_CATCHUP) * TICK_MS;
+            ticks = MAX_CATCHUP;
         }
-        st.prev_orange_drawn = true;
+        uint32_t t0 = hlc_perf_now();
+        do {
+            tick_time += TICK_MS;
+            update_game();
+        } while (--ticks && !slice_over());
+        hlc_perf_lap(PERF_UPDATE, t0);
     }
 
-    // ── Layer 2: Icons ──
-    for (int i = 0; i < MAX_ICONS; i++) {
-        st.icons[i].prev_drawn = false;
-        if (!st.icons[i].active) continue;
-        uint8_t t = st.icons[i].type;
-        draw_icon_sprite(st.icons[i].x, st.icons[i].y, icon_sprites[t],
-                         icon_colors[t][0], icon_colors[t][1], icon_colors[t][2]);
-        st.icons[i].prev_drawn = true;
-        st.icons[i].prev_x = st.icons[i].x;
-        st.icons[i].prev_y = st.icons[i].y;
+    // A keypress ends a slow interval at the next tick boundary
+    if (in.activity != seen_activity) {
+        seen_activity = in.activity;
+        if ((int32_t)(next_frame - (tick_time + TICK_MS)) > 0) next_frame = tick_time + TICK_MS;
     }
 
-    // ── Layer 3: Overlays (zzz, ?, DEAD) ──
-    if (st.anim_state == ANIM_SLEEP)
-        draw_zzz(st.cat_x, st.cat_y, st.frame);
-    else if (st.anim_state == ANIM_SIT)
-        draw_question(st.cat_x, st.cat_y, st.frame);
-    else if (st.is_dead)
-        draw_dead_text();
+    if (frame_stage == FRAME_IDLE) {
+        // Start a frame once one is due and the panel has taken the last one
+        if ((int32_t)(now - next_frame) < 0 || frame_pending()) {
+#if !defined(HLC_CORE1_ENABLE) && !defined(HLC_RENDER_THREAD)
+            hlc_journal_task();  // no frame this pass: a flash write cannot stall one
+#endif
+            return;
+        }
+        // ...and every due tick has run, with some of the slice left
+        if (now - tick_time >= TICK_MS || slice_over()) return;
+
+        // A fast stretch lags from the frame after the one that sees it start,
+        // which the period below puts on the next tick boundary
+        bool fast = !INTERP && frame_fast();
+        if (!INTERP && !fast) lagging = false;
+        interp_t = lagging ? now - tick_time : 0;
+        // Next frame on the grid of its period from the current tick: multiples
+        // of TICK_MS land on tick boundaries, shorter periods fall between them
+        cur_frame_ticks = frame_ticks();
+        uint16_t period = cur_frame_ticks > 1 ? cur_frame_ticks * TICK_MS
+                        : fast && lagging     ? FAST_RENDER_MS
+                                              : RENDER_MS;
+        if (fast) lagging = true;
+        next_frame = tick_time + ((now - tick_time) / period + 1) * period;
+        frame_stage = FRAME_SCENE;
+    }
 
-    // ── Layer 4 (top): Main cat — always on top of everything ──
-    if (cat_dirty)
-        draw_cat(st.cat_x, render_y, sprite,
-                 st.facing_left, cat_bright, cat_palette);
+    draw_step();
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// CORE1 — optional: the game and the drawing on the RP2040's second core
+// With HLC_CORE1_ENABLE, core1 loops over tama_pass() and core0 keeps SPI,
+// flash and all of QMK. Each housekeeping pass core0 publishes the inputs
+// through a seqlock and, once core1 hands over a frame, flushes its damage
+// and applies the panel mode. Keypresses already cross over lock-free in
+// the key ring. Core1 parks between passes whenever core0 writes flash.
+// ═══════════════════════════════════════════════════════════════════════
+
+#ifdef HLC_CORE1_ENABLE
+static hlc_seqlock_t inputs_lock;
+static inputs_t      inputs_shared;
+
+static void inputs_publish(bool suspended) {
+    hlc_seqlock_write_begin(&inputs_lock);
+    inputs_shared.activity = last_matrix_activity_time();
+    inputs_shared.suspended = suspended;
+    hlc_seqlock_write_end(&inputs_lock);
+}
+
+// Once per frame, before core1 may start the next one
+static void inputs_publish_wpm(void) {
+    hlc_seqlock_write_begin(&inputs_lock);
+    inputs_shared.wpm = get_current_wpm();
+    hlc_seqlock_write_end(&inputs_lock);
+}
 
-    // ── Single flush ──
-    qp_surface_draw(lcd_surface, lcd, 0, 0, 0);
-    qp_flush(lcd);
+static void inputs_read(void) {
+    uint32_t s;
+    do {
+        s = hlc_seqlock_read_begin(&inputs_lock);
+        in = inputs_shared;
+    } while (hlc_seqlock_read_retry(&inputs_lock, s));
+}
 
-    // ── Store previous state ──
-    st.prev_cat_x = st.cat_x;
-    st.prev_cat_y = render_y;
-    st.prev_sprite = sprite;
-    st.prev_cat_bright = cat_bright;
-    st.prev_cat_facing = st.facing_left;
-    st.prev_was_dead = st.is_dead;
+// Core0, each housekeeping pass: take a finished frame once the panel has
+// the last one; otherwise it is a good pass for a journal write
+static void frame_take(void) {
+    if (!frame_pending()) {
+        hlc_journal_task();
+        return;
+    }
+    if (hlc_flush_busy()) return;
+    panel_apply();  // before the flush, as in frame_out()
+    hlc_damage_flush();
+    inputs_publish_wpm();
+    __atomic_store_n(&frame_ready, 0, __ATOMIC_RELEASE);
 }
 
+// Core1. The slice still bounds a pass, and with it how long a park
+// waits; with no frame in progress core1 sleeps until core0's next pass.
+static void core1_loop(void) {
+    for (;;) {
+        hlc_core1_safe_point();
+        inputs_read();
+        if (in.suspended) {
+            hlc_core1_idle();
+            continue;
+        }
+        hlc_entropy_task();
+        uint32_t t0 = hlc_perf_now();
+        slice_end = hlc_us_now() + SLICE_US;
+        tama_pass();
+        hlc_perf_lap(PERF_PASS, t0);
+        if (frame_stage == FRAME_IDLE) hlc_core1_idle();
+    }
+}
+#else
+static void inputs_read(void) {
+    in.activity = last_matrix_activity_time();
+    in.suspended = false;
+}
+#endif
+
 // ═══════════════════════════════════════════════════════════════════════
 // QMK HOOKS
 // ═══════════════════════════════════════════════════════════════════════
 
 bool module_post_init_user(void) {
-#ifdef TAMAGOTCHI_ON_RIGHT
-    if (is_keyboard_left()) return true;
-#else
-    if (!is_keyboard_left()) return true;
-#endif
+    if (!tama_here()) return true;
 
-    srand(timer_read32());
-    uint32_t now = timer_read32();
+    atlas_init();
+    glyph_tiles_init();
+    perf_register_phases();
+    uint32_t now = tama_now();
 
     st.cat_x = (SCR_W - CAT_W) / 2;
     st.cat_y = GAME_Y + (GAME_H - CAT_H) / 2;
-    st.prev_cat_x = st.cat_x;
-    st.prev_cat_y = st.cat_y;
     st.facing_left = false;
     st.is_dead = false;
-    st.prev_was_dead = false;
     st.health = MAX_HEALTH;
     st.last_drain = now;
     st.last_active = now;
     st.last_icon_spawn = now;
+    st.keys_to_icon = ICON_KEYS_MIN;
     st.next_icon_type = 0;
     st.frame = 0;
     st.anim_state = ANIM_IDLE;
     st.bounce_timer = 0;
     st.prev_wpm = 255;          // force first redraw
     st.prev_half_hearts = 255;
-    st.cur_wpm = 0;
-    st.prev_sprite = NULL;      // force first cat draw
-    st.prev_cat_bright = 0;
-    st.prev_cat_facing = false;
 
-    // Level / XP — load saved progress or start fresh
     st.level = 1;
     st.xp = 0;
-    load_progress();
-    st.xp_next = xp_for_level(st.level);
-    st.xp_bar_div = st.xp_next / XP_BAR_W;
-    if (st.xp_bar_div == 0) st.xp_bar_div = 1;
-    if (st.xp >= st.xp_next) st.xp = 0;  // sanity clamp
     st.prev_level = 0;         // force first redraw
     st.prev_bar_fill = 255;
     last_save_time = now;
 
     // Orange cat encounter init
     st.orange_phase = ORANGE_NONE;
-    st.prev_orange_drawn = false;
-    st.prev_orange_sprite = NULL;
-    st.prev_orange_facing = false;
     st.last_orange_check = now;
 
-    for (int i = 0; i < MAX_ICONS; i++) {
+    for (int i = 0; i < MAX_ICONS; i++)
         st.icons[i].active = false;
-        st.icons[i].prev_drawn = false;
-    }
 
     pick_new_target();
+
+    // Saved state, over the defaults above
+    load_state();
+    icons_reindex();
+    interp_begin_tick();
+    st.xp_next = xp_for_level(st.level);
+    st.xp_bar_div = st.xp_next / XP_BAR_W;
+    if (st.xp_bar_div == 0) st.xp_bar_div = 1;
+    if (st.xp >= st.xp_next) st.xp = 0;  // sanity clamp
+    tick_time = next_frame = now;
+    seen_activity = last_matrix_activity_time();
     tama_inited = true;
 
     // Initial full screen draw: black top bar + grass game area
@@ -1061,57 +2300,61 @@ bool module_post_init_user(void) {
     draw_wpm(get_current_wpm());
     draw_hearts(st.health / 10);
     draw_level_bar(st.level, 0);
-    draw_cat(st.cat_x, st.cat_y, anim_sit[0], false, 255, cat_palette);
+    static const hlc_rect_t game_area = {0, GAME_Y, SCR_W - 1, LVL_Y - 1};
+    build_scene(&scenes[scene_cur]);
+    compose_queue(&game_area, 1);
+    while (!compose_run(&scenes[scene_cur])) {}
+
+    hlc_damage_all();  // full initial blit
+    hlc_damage_flush();
+    hlc_flush_wait();
+#ifndef HLC_RENDER_THREAD
+    hlc_flush_slice(SLICE_US);  // from here on, one deadline per pass, flush included
+#endif
 
-    qp_surface_draw(lcd_surface, lcd, 0, 0, true);  // full initial blit
-    qp_flush(lcd);
+#ifdef HLC_CORE1_ENABLE
+    inputs_publish(false);
+    inputs_publish_wpm();
+    hlc_core1_launch(core1_loop);
+#endif
 
     return true;  // signal success to Halcyon module framework
 }
 
+// Save once when suspend starts; halcyon.c commits the journal right
+// after. QMK calls this on every pass of its suspend loop, about every
+// 17 ms, so suspend_saved holds it off until wakeup. Core1 is parked for
+// the save, between passes, so the state is read whole.
+static bool suspend_saved = false;
+
+void suspend_power_down_user(void) {
+    if (!tama_inited || suspend_saved) return;
+    suspend_saved = true;
+    hlc_core1_park();
+    save_state();
+    hlc_core1_release();
+#ifdef HLC_CORE1_ENABLE
+    inputs_publish(true);  // core1 sleeps until the first pass after wakeup
+#endif
+}
+
+void suspend_wakeup_init_user(void) {
+    suspend_saved = false;
+}
+
 bool display_module_housekeeping_task_user(bool second_display) {
     if (!tama_inited) return true;     // before init, let framework handle
     if (second_display) return false;  // prevent framework surface flush from overwriting our LCD draws
 
-    // Auto-save XP progress every 5 minutes
-    if (timer_elapsed32(last_save_time) >= SAVE_INTERVAL) {
-        save_progress();
-        last_save_time = timer_read32();
-    }
-
-    if (timer_elapsed32(last_frame_time) < FRAME_MS) return false;  // nothing to draw, skip framework flush
-    last_frame_time = timer_read32();
-
-    update_game();
-
-#if SHOW_FRAME_TIMING
-    uint32_t t0 = timer_read32();
-#endif
-
-    draw_frame();    // draws to surface + flushes + draws orange cat on LCD
-
-#if SHOW_FRAME_TIMING
-    {
-        uint8_t ms = (uint8_t)timer_elapsed32(t0);
-        if (ms != last_frame_ms) {
-            // Clear old digits (3-digit max: "999")
-            qp_rect(lcd_surface, SCR_W - 30, LVL_Y, SCR_W - 1, LVL_Y + 9, 0, 0, 0, true);
-            // Draw ms value in small text at bottom-right
-            uint8_t d[3] = { ms / 100, (ms / 10) % 10, ms % 10 };
-            int start = (d[0] == 0) ? ((d[1] == 0) ? 2 : 1) : 0;
-            int16_t x = SCR_W - (3 - start) * 8;
-            uint8_t v = (ms > 50) ? 255 : 120;  // bright red if slow
-            uint8_t hue = (ms > 50) ? 0 : 85;   // red if >50ms, green otherwise
-            for (int i = start; i < 3; i++) {
-                draw_glyph(x, LVL_Y, digits_3x5[d[i]], 2, hue, 200, v);
-                x += 8;
-            }
-            qp_surface_draw(lcd_surface, lcd, 0, 0, 0);
-            qp_flush(lcd);
-            last_frame_ms = ms;
-        }
-    }
+#ifdef HLC_CORE1_ENABLE
+    inputs_publish(false);
+    frame_take();
+#else
+    uint32_t t0 = hlc_perf_now();
+    slice_end = hlc_pass_end();  // shared with the flush before and after this pass
+    inputs_read();
+    tama_pass();
+    hlc_perf_lap(PERF_PASS, t0);
 #endif
-
     return false;    // skip framework's update_display() and redundant flush
 }
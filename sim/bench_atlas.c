@@ -0,0 +1,161 @@
+// bench_atlas.c — cat drawing microbenchmark.
+//
+// Draws every atlas frame, both ways round, in the cat and orange tiers
+// and at positions clipped by every screen edge, two ways: through the
+// compositor from the pre-decoded atlas (one cat in the scene, its rect
+// queued and composed), and with the original draw_cat, which cleared
+// the cat's box and issued one qp_rect per same-colour run, each with its
+// own HSV conversion. Checks both leave the same framebuffer for every
+// draw, then times each. The mock qp_rect converts the colour once and
+// streams it through viewport/pixdata like QP's.
+//
+// The keymap is included here rather than linked, like in bench_particles.
+//
+//   bench_atlas [iterations]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "halcyon.h"
+#include "sim.h"
+#include "tamagotchi.c"
+
+#define ITERATIONS 200
+#define POSITIONS  16      // per frame, mirror and tier
+
+#define FB_BYTES (SCR_W * SCR_H * sizeof(uint16_t))
+
+// ─── Reference: the original per-run qp_rect path ───
+static void ref_clear_rect(int16_t x, int16_t y, int16_t w, int16_t h) {
+    int16_t x1 = (x < 0) ? 0 : x;
+    int16_t y1 = (y < GAME_Y) ? GAME_Y : y;
+    int16_t x2 = x + w - 1; if (x2 >= SCR_W) x2 = SCR_W - 1;
+    int16_t y2 = y + h - 1; if (y2 >= LVL_Y) y2 = LVL_Y - 1;
+    if (x1 <= x2 && y1 <= y2)
+        qp_rect(lcd_surface, x1, y1, x2, y2, 0, 0, 0, true);
+}
+
+static void ref_draw_cat(int16_t ox, int16_t oy, const uint32_t *sprite,
+                         bool mirror, uint8_t brightness,
+                         const uint8_t (*palette)[3]) {
+    for (int row = 0; row < CAT_BMP_H; row++) {
+        uint32_t bits = sprite[row];
+        if (!bits) continue;
+        int16_t py = oy + row * CAT_SCALE;
+        int16_t py2 = py + CAT_SCALE - 1;
+        if (py2 < GAME_Y || py >= LVL_Y) continue;
+        if (py < GAME_Y) py = GAME_Y;
+        if (py2 >= LVL_Y) py2 = LVL_Y - 1;
+        int col = 0;
+        while (col < CAT_BMP_W) {
+            int src_col = mirror ? (CAT_BMP_W - 1 - col) : col;
+            uint8_t c = (bits >> (2 * (CAT_BMP_W - 1 - src_col))) & 3;
+            if (c == 0) { col++; continue; }
+            int run = 1;
+            while (col + run < CAT_BMP_W) {
+                int ns = mirror ? (CAT_BMP_W - 1 - (col + run)) : (col + run);
+                if (((bits >> (2 * (CAT_BMP_W - 1 - ns))) & 3) != c) break;
+                run++;
+            }
+            int16_t px = ox + col * CAT_SCALE;
+            int16_t px2 = px + run * CAT_SCALE - 1;
+            if (px2 < 0 || px >= SCR_W) { col += run; continue; }
+            if (px < 0) px = 0;
+            if (px2 >= SCR_W) px2 = SCR_W - 1;
+            const uint8_t *pal = palette[c];
+            uint8_t v = (uint16_t)pal[2] * brightness / 255;
+            qp_rect(lcd_surface, px, py, px2, py2, pal[0], pal[1], v, true);
+            col += run;
+        }
+    }
+}
+
+// ─── Bench ───
+typedef struct {
+    const uint32_t *sprite;
+    int16_t x, y;
+    bool    mirror;
+    uint8_t tier;
+} draw_t;
+
+static draw_t draws[ATLAS_FRAMES * 2 * 2 * POSITIONS];
+static int    n_draws;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void draw_ref(const draw_t *d) {
+    ref_clear_rect(d->x, d->y, CAT_W, CAT_H);
+    ref_draw_cat(d->x, d->y, d->sprite, d->mirror, tier_defs[d->tier].brightness,
+                 tier_defs[d->tier].palette);
+}
+
+static void draw_atlas(const draw_t *d) {
+    scene_t    sc = {0};
+    hlc_rect_t r;
+    scene_add_cat(&sc, d->x, d->y, d->sprite, d->mirror, d->tier);
+    if (!sc.n || !sprite_rect(&sc.spr[0], &r)) return;
+    compose_queue(&r, 1);
+    while (!compose_run(&sc)) {}
+}
+
+static double time_draws(void (*draw)(const draw_t *), int iterations) {
+    double t0 = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        for (int k = 0; k < n_draws; k++) draw(&draws[k]);
+    }
+    return (now_ns() - t0) / ((double)iterations * n_draws);
+}
+
+int main(int argc, char **argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : ITERATIONS;
+    static const uint8_t tiers[] = {TIER_CAT, TIER_ORANGE};
+    static uint8_t ref_fb[FB_BYTES];
+
+    module_post_init_kb();
+    slice_end = hlc_us_now() + 0x40000000;  // one slice for the whole run
+
+    // Positions stepped across and past every edge of the game area
+    for (size_t a = 0; a < sizeof(atlas_anims) / sizeof(atlas_anims[0]); a++) {
+        for (int f = 0; f < atlas_anims[a].count; f++) {
+            for (int m = 0; m < 2; m++) {
+                for (int t = 0; t < 2; t++) {
+                    for (int p = 0; p < POSITIONS; p++, n_draws++) {
+                        draws[n_draws] = (draw_t){
+                            .sprite = atlas_anims[a].frames[f],
+                            .x = -CAT_W / 2 + (n_draws * 7) % (SCR_W + CAT_W / 2),
+                            .y = GAME_Y - CAT_H / 2 + (n_draws * 13) % (LVL_Y - GAME_Y + CAT_H / 2),
+                            .mirror = m, .tier = tiers[t],
+                        };
+                    }
+                }
+            }
+        }
+    }
+
+    for (int k = 0; k < n_draws; k++) {
+        memset(lcd_surface_fb, 0, FB_BYTES);
+        draw_ref(&draws[k]);
+        memcpy(ref_fb, lcd_surface_fb, FB_BYTES);
+        memset(lcd_surface_fb, 0, FB_BYTES);
+        draw_atlas(&draws[k]);
+        if (memcmp(ref_fb, lcd_surface_fb, FB_BYTES)) {
+            printf("draw %d (x %d, y %d, mirror %d, tier %d) differs from the original\n", k,
+                   draws[k].x, draws[k].y, draws[k].mirror, draws[k].tier);
+            return 1;
+        }
+    }
+
+    uint64_t rects = sim_counters.rect_calls;
+    double   ref   = time_draws(draw_ref, iterations);
+    double   per   = (double)(sim_counters.rect_calls - rects) / ((double)iterations * n_draws);
+    double   atl   = time_draws(draw_atlas, iterations);
+    printf("%d draws (%d frames x 2 mirrors x 2 tiers x %d positions), %d iterations\n",
+           n_draws, (int)ATLAS_FRAMES, POSITIONS, iterations);
+    printf("original qp_rect  %8.0f ns/cat  (%.1f qp_rect calls)\n", ref, per);
+    printf("atlas compose     %8.0f ns/cat  (%.2fx)\n", atl, ref / atl);
+    return 0;
+}
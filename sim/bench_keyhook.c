@@ -0,0 +1,71 @@
+// bench_keyhook.c — keypress hook microbenchmark.
+//
+// Feeds process_record_user a long run of press and release records, as
+// the master does for every key of both halves, and times each kind. A
+// press stamps the clock into the key ring with key_push; the ring is
+// drained between batches, outside the timing, as a game tick would, so
+// no press lands in a full ring. The cost of reading the clock around a
+// batch is measured first and taken off.
+//
+// The keymap is included here rather than linked, like in bench_particles.
+//
+//   bench_keyhook [iterations]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "halcyon.h"
+#include "sim.h"
+#include "tamagotchi.c"
+
+#define ITERATIONS 200000
+#define BATCH      (KEY_RING - 1)   // presses between drains
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Best of 5, in ns per record
+static double time_records(bool pressed, int iterations) {
+    keyrecord_t record = {.event = {.pressed = pressed}};
+    double      best   = 1e18;
+    for (int run = 0; run < 5; run++) {
+        double   total = 0, clock = 0;
+        uint32_t last;
+        for (int i = 0; i < iterations; i++) {
+            double t0 = now_ns();
+            double t1 = now_ns();
+            for (int k = 0; k < BATCH; k++) process_record_user(k, &record);
+            double t2 = now_ns();
+            clock += t1 - t0;
+            total += t2 - t1;
+            key_drain(&last);
+        }
+        double t = (total - clock) / ((double)iterations * BATCH);
+        if (t < best) best = t;
+    }
+    return best;
+}
+
+int main(int argc, char **argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : ITERATIONS;
+    keyrecord_t press = {.event = {.pressed = true}};
+    uint32_t    last;
+
+    module_post_init_kb();
+
+    // Every press reaches the ring, stamped with the clock
+    sim_now_ms = 1234;
+    for (int k = 0; k < BATCH; k++) process_record_user(k, &press);
+    if (key_drain(&last) != BATCH || last != sim_now_ms) {
+        printf("presses did not reach the key ring\n");
+        return 1;
+    }
+
+    printf("%d records a batch, %d iterations, ns per record\n", BATCH, iterations);
+    printf("press    %6.2f\n", time_records(true, iterations));
+    printf("release  %6.2f\n", time_records(false, iterations));
+    return 0;
+}
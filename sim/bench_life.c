@@ -0,0 +1,129 @@
+// bench_life.c — Game of Life engine microbenchmark.
+//
+// Runs hlc_life (bitboard, one word per row) against the original
+// bool[48][27] engine from the same start, checks both grids and both
+// changed masks are identical after every generation, and times each.
+//
+//   bench_life [generations]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "hlc_life.h"
+#include "hlc_random.h"
+#include "hardware/structs/rosc.h"
+
+// hlc_random.c reads the ROSC; the bench never runs the entropy task
+rosc_hw_t *sim_rosc(void) {
+    static rosc_hw_t regs;
+    return &regs;
+}
+
+#define GENERATIONS   10000
+#define CLUSTER_EVERY 25   // inject a 3x3 cluster, like a keypress would
+
+// ─── Reference: the original bool-array engine ───
+static bool grid[HLC_LIFE_H][HLC_LIFE_W];
+static bool new_grid[HLC_LIFE_H][HLC_LIFE_W];
+static bool changed_grid[HLC_LIFE_H][HLC_LIFE_W];
+
+static void ref_update_grid(void) {
+    for (int y = 0; y < HLC_LIFE_H; y++) {
+        for (int x = 0; x < HLC_LIFE_W; x++) {
+            int alive_neighbors = 0;
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    if (dy == 0 && dx == 0) continue;
+                    int ny = y + dy;
+                    int nx = x + dx;
+                    if (ny >= 0 && ny < HLC_LIFE_H && nx >= 0 && nx < HLC_LIFE_W) {
+                        alive_neighbors += grid[ny][nx];
+                    }
+                }
+            }
+            if (grid[y][x]) {
+                new_grid[y][x] = (alive_neighbors == 2 || alive_neighbors == 3);
+            } else {
+                new_grid[y][x] = (alive_neighbors == 3);
+            }
+            changed_grid[y][x] = (grid[y][x] != new_grid[y][x]);
+        }
+    }
+    for (int y = 0; y < HLC_LIFE_H; y++) {
+        for (int x = 0; x < HLC_LIFE_W; x++) {
+            grid[y][x] = new_grid[y][x];
+        }
+    }
+}
+
+static void ref_add_cell_cluster(void) {
+    int cluster_size = 3;
+    int x = hlc_random_below(HLC_LIFE_W - cluster_size);
+    int y = hlc_random_below(HLC_LIFE_H - cluster_size);
+    for (int dy = 0; dy < cluster_size; dy++) {
+        for (int dx = 0; dx < cluster_size; dx++) {
+            bool is_alive = hlc_random() & 1;
+            grid[y + dy][x + dx] = is_alive;
+            changed_grid[y + dy][x + dx] = true;
+        }
+    }
+}
+
+// ─── Harness ───
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int compare(const hlc_life_t *life) {
+    for (int y = 0; y < HLC_LIFE_H; y++) {
+        for (int x = 0; x < HLC_LIFE_W; x++) {
+            if (hlc_life_alive(life, x, y) != grid[y][x]) return 1;
+            if (((life->changed[y] >> x) & 1) != changed_grid[y][x]) return 2;
+        }
+        if ((life->rows[y] | life->changed[y]) & ~HLC_LIFE_MASK) return 3;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    int        generations = argc > 1 ? atoi(argv[1]) : GENERATIONS;
+    hlc_life_t life;
+
+    hlc_random_seed(1);
+    hlc_life_seed(&life, 20);
+    for (int y = 0; y < HLC_LIFE_H; y++)
+        for (int x = 0; x < HLC_LIFE_W; x++) grid[y][x] = hlc_life_alive(&life, x, y);
+
+    // Correctness: lockstep, same random stream for the clusters
+    for (int g = 0; g < generations; g++) {
+        ref_update_grid();
+        hlc_life_step(&life);
+        if (g % CLUSTER_EVERY == 0) {
+            hlc_random_t saved = hlc_rng;
+            ref_add_cell_cluster();
+            hlc_rng = saved;
+            hlc_life_cluster(&life, 3);
+        }
+        int err = compare(&life);
+        if (err) {
+            printf("generation %d: %s differs\n", g, err == 1 ? "grid" : err == 2 ? "changed mask" : "padding");
+            return 1;
+        }
+    }
+    printf("%d generations bit-identical\n", generations);
+
+    // Speed: step only, from the state reached above
+    double t0 = now_ns();
+    for (int g = 0; g < generations; g++) ref_update_grid();
+    double t1 = now_ns();
+    for (int g = 0; g < generations; g++) hlc_life_step(&life);
+    double t2 = now_ns();
+
+    double ref = (t1 - t0) / generations, bit = (t2 - t1) / generations;
+    printf("bool[%d][%d]  %8.0f ns/generation\n", HLC_LIFE_H, HLC_LIFE_W, ref);
+    printf("bitboard     %8.0f ns/generation (%.0fx)\n", bit, ref / bit);
+    return 0;
+}
@@ -0,0 +1,179 @@
+// bench_matrix.c — encoder module matrix scan microbenchmark.
+//
+// Runs hlc_encoder's matrix_read_cols_on_row (one SIO load per row)
+// against the original, which reconfigured the row pin through PAL and
+// read each column with gpio_read_pin, on a fake SIO block. Checks both
+// read the same rows for every column pattern, then times each with no
+// key held and with three held.
+//
+// PAL is modelled as on ChibiOS for the RP2040: a pin mode change is an
+// out-of-line call that writes SIO OE, the pad control and the function
+// select, and ATOMIC_BLOCK_FORCEON masks interrupts around it. QMK's
+// select and unselect delays are left out of both. The host's stores go
+// to RAM, where the chip's pad and IO_BANK0 writes cross the APB bridge,
+// so the host understates what the original costs.
+//
+// The module is included here rather than linked, like the keymap in
+// bench_particles.
+//
+//   bench_matrix [iterations]
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "hardware/structs/sio.h"
+#include "hlc_encoder/config.h"
+
+#define ITERATIONS 1000000
+
+// ─── A half of the board, as QMK sees it ───
+typedef uint32_t pin_t;
+typedef uint8_t  matrix_row_t;
+
+#define NO_PIN             ((pin_t)~0)
+#define COL2ROW            0
+#define ROW2COL            1
+#define DIODE_DIRECTION    COL2ROW
+#define SPLIT_KEYBOARD
+#define MATRIX_ROWS        12
+#define MATRIX_COLS        7
+#define MATRIX_ROW_SHIFTER ((matrix_row_t)1)
+#define MATRIX_ROW_PINS    {GP0, GP1, GP2, GP3, GP4, GP5}
+#define MATRIX_COL_PINS    {GP6, GP7, GP8, GP9, GP10, GP11, GP12}
+
+enum { GP0, GP1, GP2, GP3, GP4, GP5, GP6, GP7, GP8, GP9, GP10, GP11, GP12, GP13, GP14, GP15, GP16 };
+
+enum { PAL_MODE_OUTPUT, PAL_MODE_INPUT_PULLUP };
+
+sio_hw_t sim_sio;
+bool     isLeftHand = true;
+
+static volatile uint32_t primask;
+static volatile uint32_t pads[30], ctrl[30];
+
+__attribute__((noinline)) static void pal_set_line_mode(pin_t pin, int mode) {
+    if (mode == PAL_MODE_OUTPUT) {
+        sio_hw->gpio_oe_set = 1u << pin;
+        pads[pin]           = 0x56;  // output, 4 mA, Schmitt trigger
+    } else {
+        sio_hw->gpio_oe_clr = 1u << pin;
+        pads[pin]           = 0x4a;  // input, pull-up
+    }
+    ctrl[pin] = 5;  // function select: SIO
+}
+
+#define gpio_set_pin_output(pin)     pal_set_line_mode(pin, PAL_MODE_OUTPUT)
+#define gpio_set_pin_input_high(pin) pal_set_line_mode(pin, PAL_MODE_INPUT_PULLUP)
+#define gpio_write_pin_low(pin)      (sio_hw->gpio_clr = 1u << (pin))
+#define gpio_write_pin_high(pin)     (sio_hw->gpio_set = 1u << (pin))
+#define gpio_read_pin(pin)           ((sio_hw->gpio_in >> (pin)) & 1)
+#define ATOMIC_BLOCK_FORCEON         for (int atomic = (primask = 1); atomic; primask = 0, atomic = 0)
+
+__attribute__((noinline)) void matrix_output_select_delay(void) {
+    __asm__ volatile("");
+}
+
+__attribute__((noinline)) void matrix_output_unselect_delay(uint8_t line, bool key_pressed) {
+    __asm__ volatile("");
+}
+
+#include "hlc_encoder/hlc_encoder.c"
+
+// ─── Reference: the original scan ───
+static inline void setPinOutput_writeLow(pin_t pin) {
+    ATOMIC_BLOCK_FORCEON {
+        gpio_set_pin_output(pin);
+        gpio_write_pin_low(pin);
+    }
+}
+
+static inline void setPinInputHigh_atomic(pin_t pin) {
+    ATOMIC_BLOCK_FORCEON {
+        gpio_set_pin_input_high(pin);
+    }
+}
+
+static inline uint8_t readMatrixPin(pin_t pin) {
+    if (pin != NO_PIN) {
+        return (gpio_read_pin(pin) == MATRIX_INPUT_PRESSED_STATE) ? 0 : 1;
+    } else {
+        return 1;
+    }
+}
+
+static void ref_read_cols_on_row(matrix_row_t current_matrix[], uint8_t current_row) {
+    matrix_row_t current_row_value = 0;
+
+    setPinOutput_writeLow(row_pins[current_row]);
+    matrix_output_select_delay();
+
+    if (current_row == (ROWS_PER_HAND - 1)) {
+        current_row_value |= ((!gpio_read_pin(HLC_ENCODER_BUTTON)) & 1) << 0;
+    } else {
+        matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
+        for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++, row_shifter <<= 1) {
+            uint8_t pin_state = readMatrixPin(col_pins[col_index]);
+            current_row_value |= pin_state ? 0 : row_shifter;
+        }
+    }
+
+    if (row_pins[current_row] != NO_PIN) setPinInputHigh_atomic(row_pins[current_row]);
+    matrix_output_unselect_delay(current_row, current_row_value != 0);
+
+    current_matrix[current_row] = current_row_value;
+}
+
+// ─── Bench ───
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Best of 5, in ns per row
+static double time_scan(void (*read_row)(matrix_row_t[], uint8_t), uint32_t in, int iterations) {
+    matrix_row_t matrix[ROWS_PER_HAND];
+    double       best = 1e18;
+    sim_sio.gpio_in = in;
+    for (int run = 0; run < 5; run++) {
+        double t0 = now_ns();
+        for (int i = 0; i < iterations; i++) {
+            for (uint8_t row = 0; row < ROWS_PER_HAND; row++) read_row(matrix, row);
+        }
+        double t = (now_ns() - t0) / ((double)iterations * ROWS_PER_HAND);
+        if (t < best) best = t;
+    }
+    return best;
+}
+
+int main(int argc, char **argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : ITERATIONS;
+
+    matrix_init_kb();
+
+    // Every column pattern, with the button up and down
+    for (uint32_t keys = 0; keys < 1u << (MATRIX_COLS + 1); keys++) {
+        matrix_row_t ref[ROWS_PER_HAND], got[ROWS_PER_HAND];
+        sim_sio.gpio_in = ~((keys & 0x7f) << GP6 | (keys >> MATRIX_COLS) << HLC_ENCODER_BUTTON);
+        for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+            ref_read_cols_on_row(ref, row);
+            matrix_read_cols_on_row(got, row);
+            if (got[row] != ref[row]) {
+                printf("keys %02x row %u: %02x, original %02x\n", keys, row, got[row], ref[row]);
+                return 1;
+            }
+        }
+    }
+
+    uint32_t idle = ~0u;
+    uint32_t held = ~(1u << GP6 | 1u << GP8 | 1u << GP11);
+    printf("%d rows of %d columns, %d iterations, ns per row\n", ROWS_PER_HAND, MATRIX_COLS, iterations);
+    printf("               original   one load\n");
+    printf("nothing held   %8.2f   %8.2f\n", time_scan(ref_read_cols_on_row, idle, iterations),
+           time_scan(matrix_read_cols_on_row, idle, iterations));
+    printf("three held     %8.2f   %8.2f\n", time_scan(ref_read_cols_on_row, held, iterations),
+           time_scan(matrix_read_cols_on_row, held, iterations));
+    return 0;
+}
@@ -0,0 +1,93 @@
+// bench_particles.c — particle pool microbenchmark.
+//
+// Fills the pool to PART_MAX, spread over the whole game area, and times
+// each per-frame pass on it: particles_update (integrate and compact),
+// particles_bucket (row buckets and covered cells), and particles_present
+// together with the recompose of the cells it queues. For scale, the same
+// is set against a recompose of the whole game area with no particles,
+// which an ordinary frame with the orange cat on screen already costs.
+//
+// The pool is static in tamagotchi.c, so the keymap is included here
+// rather than linked.
+//
+//   bench_particles [iterations]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "halcyon.h"
+#include "tamagotchi.c"
+
+#define ITERATIONS 20000
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Uniform over the game area, away from the edges so none leave in a tick
+static void fill_pool(void) {
+    hlc_random_seed(1);
+    while (parts.n < PART_MAX) {
+        part_emit(8 + hlc_random_below(SCR_W - 16), GAME_Y + 8 + hlc_random_below(GAME_H - 16),
+                  (int16_t)hlc_random_below(PART_ONE + 1) - PART_ONE / 2,
+                  -(int16_t)hlc_random_below(PART_ONE + 1), 200,
+                  hlc_native_color(hlc_random_below(256), 255, 255));
+    }
+}
+
+int main(int argc, char **argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : ITERATIONS;
+    static const hlc_rect_t game_area = {0, GAME_Y, SCR_W - 1, LVL_Y - 1};
+
+    module_post_init_kb();
+    const scene_t *sc = &scenes[scene_cur];
+    fill_pool();
+    typeof(parts) full = parts;
+
+    double update = 0, bucket = 0, present = 0;
+    int    cells = 0;
+    for (int i = 0; i < iterations; i++) {
+        parts = full;
+        slice_end = hlc_us_now() + 0x40000000;  // one slice for the whole pass
+        double t0 = now_ns();
+        particles_update();
+        double t1 = now_ns();
+        particles_bucket();
+        double t2 = now_ns();
+        particles_present();
+        while (!compose_run(sc)) {}
+        double t3 = now_ns();
+        if (parts.n != PART_MAX) {
+            printf("iteration %d: %u particles left the area\n", i, parts.n);
+            return 1;
+        }
+        update += t1 - t0;
+        bucket += t2 - t1;
+        present += t3 - t2;
+    }
+    for (int row = 0; row < CELL_ROWS; row++) cells += __builtin_popcount(part_cells[1][row]);
+
+    parts.n = 0;
+    double t0 = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        slice_end = hlc_us_now() + 0x40000000;
+        compose_queue(&game_area, 1);
+        while (!compose_run(sc)) {}
+    }
+    double area = (now_ns() - t0) / iterations;
+
+    update /= iterations;
+    bucket /= iterations;
+    present /= iterations;
+    double total = update + bucket + present;
+    printf("%d particles, %d of %d cells covered, %d iterations\n",
+           PART_MAX, cells, CELL_ROWS * CELL_COLS, iterations);
+    printf("update            %8.0f ns\n", update);
+    printf("bucket            %8.0f ns\n", bucket);
+    printf("present+compose   %8.0f ns\n", present);
+    printf("total             %8.0f ns/frame\n", total);
+    printf("game area compose %8.0f ns (full pool = %.2fx)\n", area, total / area);
+    return 0;
+}
@@ -0,0 +1,76 @@
+// ch.h — the slice of the ChibiOS RT kernel HLC_RENDER_THREAD uses, for the
+// simulator. There is one emulated core: the render thread is a pthread
+// that only runs while the main thread waits in chBSemWaitTimeout() or
+// chMtxLock(), and is stopped wherever it stands when the wait ends, as
+// the scheduler preempts it on the keyboard. Virtual timers fire from the
+// simulator's virtual clock, through sim_vt_run().
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef int32_t  msg_t;
+typedef uint32_t sysinterval_t;  // µs
+typedef uint32_t tprio_t;
+
+#define MSG_OK      0
+#define MSG_TIMEOUT -1
+#define NORMALPRIO  128
+
+#define TIME_MS2I(ms) ((sysinterval_t)(ms) * 1000)
+#define TIME_US2I(us) ((sysinterval_t)(us))
+
+typedef struct {
+    bool taken;
+} binary_semaphore_t;
+
+typedef struct {
+    bool owned;
+} mutex_t;
+
+typedef struct {
+    int id;
+} thread_t;
+
+typedef struct virtual_timer virtual_timer_t;
+typedef void (*vtfunc_t)(virtual_timer_t *vtp, void *p);
+typedef void (*tfunc_t)(void *arg);
+
+struct virtual_timer {
+    uint32_t         period_ms;
+    uint32_t         next_ms;    // sim_now_ms of the next expiry
+    vtfunc_t         func;
+    void            *par;
+    virtual_timer_t *link;       // armed timers
+};
+
+#define THD_WORKING_AREA(s, n)   uint8_t s[n]
+#define THD_FUNCTION(tname, arg) void tname(void *arg)
+#define BSEMAPHORE_DECL(name, t) binary_semaphore_t name = {t}
+#define MUTEX_DECL(name)         mutex_t name = {false}
+
+// The callers of the I-class functions already hold the kernel lock
+static inline void chSysLockFromISR(void) {}
+static inline void chSysUnlockFromISR(void) {}
+static inline void chRegSetThreadName(const char *name) {}
+
+void  chBSemSignalI(binary_semaphore_t *bsp);
+void  chBSemResetI(binary_semaphore_t *bsp, bool taken);
+void  chBSemSignal(binary_semaphore_t *bsp);
+msg_t chBSemWait(binary_semaphore_t *bsp);
+msg_t chBSemWaitTimeout(binary_semaphore_t *bsp, sysinterval_t timeout);
+
+void chMtxLock(mutex_t *mp);
+bool chMtxTryLock(mutex_t *mp);
+void chMtxUnlock(mutex_t *mp);
+
+thread_t *chThdCreateStatic(void *wsp, size_t size, tprio_t prio, tfunc_t pf, void *arg);
+
+void chVTObjectInit(virtual_timer_t *vtp);
+void chVTSetContinuous(virtual_timer_t *vtp, sysinterval_t delay, vtfunc_t vtfunc, void *par);
+
+// Simulator side: fire the virtual timers that sim_now_ms has reached, and
+// lend the core until the render thread has nothing left to do
+void sim_vt_run(void);
+void sim_ch_settle(void);
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <stdint.h>
+
+typedef struct {
+    uint8_t h, s, v;
+} hsv_t;
+
+typedef struct {
+    uint8_t r, g, b;
+} rgb_t;
+
+rgb_t hsv_to_rgb_nocie(hsv_t hsv);
+
+#define HSV_BLACK 0, 0, 0
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define TOTAL_EEPROM_BYTE_COUNT 4096
+
+uint8_t  eeprom_read_byte(const uint8_t *addr);
+uint16_t eeprom_read_word(const uint16_t *addr);
+uint32_t eeprom_read_dword(const uint32_t *addr);
+void     eeprom_read_block(void *buf, const void *addr, size_t len);
+void     eeprom_write_byte(uint8_t *addr, uint8_t value);
+void     eeprom_update_byte(uint8_t *addr, uint8_t value);
+void     eeprom_update_word(uint16_t *addr, uint16_t value);
+void     eeprom_update_dword(uint32_t *addr, uint32_t value);
+void     eeprom_update_block(const void *buf, void *addr, size_t len);
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <stdint.h>
+
+typedef struct {
+    volatile uint32_t randombit;
+} rosc_hw_t;
+
+// Every access clocks a new random bit, like the ring oscillator does
+rosc_hw_t *sim_rosc(void);
+#define rosc_hw (sim_rosc())
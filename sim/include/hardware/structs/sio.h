@@ -0,0 +1,12 @@
+#pragma once
+
+#include <stdint.h>
+
+typedef struct {
+    volatile uint32_t gpio_in, gpio_out, gpio_set, gpio_clr, gpio_oe, gpio_oe_set, gpio_oe_clr;
+} sio_hw_t;
+
+// A plain register block at a fixed address, as on the chip: the bench
+// sets gpio_in itself
+extern sio_hw_t sim_sio;
+#define sio_hw (&sim_sio)
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <stdint.h>
+
+typedef struct {
+    volatile uint32_t timerawl;
+} timer_hw_t;
+
+// Reads the host's monotonic clock in µs, so profiles time host code
+timer_hw_t *sim_timer(void);
+#define timer_hw (sim_timer())
@@ -0,0 +1,26 @@
+// Host stand-in for the Quantum Painter API used by the display code.
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "quantum.h"
+
+typedef void       *painter_device_t;
+typedef const void *painter_font_handle_t;
+typedef const void *painter_image_handle_t;
+
+typedef enum { QP_ROTATION_0, QP_ROTATION_90, QP_ROTATION_180, QP_ROTATION_270 } painter_rotation_t;
+
+bool qp_init(painter_device_t device, painter_rotation_t rotation);
+bool qp_power(painter_device_t device, bool power_on);
+bool qp_clear(painter_device_t device);
+bool qp_flush(painter_device_t device);
+void qp_set_viewport_offsets(painter_device_t device, uint16_t offset_x, uint16_t offset_y);
+bool qp_rect(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom, uint8_t hue, uint8_t sat, uint8_t val, bool filled);
+bool qp_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom);
+bool qp_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count);
+
+painter_device_t qp_st7789_make_spi_device(uint16_t panel_width, uint16_t panel_height, uint32_t chip_select_pin, uint32_t dc_pin, uint32_t reset_pin, uint16_t spi_divisor, int spi_mode);
+
+#define SURFACE_REQUIRED_BUFFER_BYTE_SIZE(w, h, bpp) ((((w) * (h) * (bpp)) + 7) / 8)
+painter_device_t qp_make_rgb565_surface(uint16_t panel_width, uint16_t panel_height, void *buffer);
@@ -0,0 +1,5 @@
+#pragma once
+
+#include "qp.h"
+
+bool qp_surface_draw(painter_device_t surface, painter_device_t display, uint16_t x, uint16_t y, bool entire_surface);
@@ -0,0 +1,55 @@
+// Host stand-in for the parts of quantum.h the display code uses.
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "color.h"
+#include "timer.h"
+#include "qp.h"
+
+typedef uint32_t layer_state_t;
+typedef union {
+    uint8_t raw;
+    struct {
+        bool num_lock : 1, caps_lock : 1, scroll_lock : 1, compose : 1, kana : 1;
+    };
+} led_t;
+
+extern layer_state_t layer_state, default_layer_state;
+
+typedef struct {
+    bool     pressed;
+    uint16_t time;
+} keyevent_t;
+
+typedef struct {
+    keyevent_t event;
+} keyrecord_t;
+
+bool process_record_user(uint16_t keycode, keyrecord_t *record);
+void suspend_power_down_user(void);
+void suspend_wakeup_init_user(void);
+
+led_t    host_keyboard_led_state(void);
+uint8_t  get_highest_layer(layer_state_t state);
+uint8_t  get_current_wpm(void);
+bool     is_keyboard_left(void);
+bool     is_keyboard_master(void);
+void     wait_ms(uint32_t ms);
+uint32_t last_matrix_activity_time(void);
+uint32_t last_input_activity_elapsed(void);
+
+void    backlight_enable(void);
+void    backlight_disable(void);
+uint8_t get_backlight_level(void);
+void    backlight_level(uint8_t level);
+
+#define BACKLIGHT_LEVELS 10
+#define HLC_BACKLIGHT_TIMEOUT 120000
+
+#define dprintf(...) do { } while (0)
+#define uprintf(...) printf(__VA_ARGS__)
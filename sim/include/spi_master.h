@@ -0,0 +1,26 @@
+// Host stand-in for spi_master plus the ChibiOS SPI calls used by
+// HLC_ASYNC_FLUSH. Bytes are decoded by an ST7789 model in mock_qp.c.
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef enum { SPI_UNINIT, SPI_STOP, SPI_READY, SPI_ACTIVE } spistate_t;
+
+typedef struct {
+    spistate_t state;
+} SPIDriver;
+
+// Every poll of the driver state advances the simulated DMA transfer
+SPIDriver *sim_spi_poll(void);
+#define SPI_DRIVER (*sim_spi_poll())
+
+bool spi_start(uint32_t slave_pin, bool lsb_first, uint8_t mode, uint16_t divisor);
+int  spi_write(uint8_t data);
+int  spi_transmit(const uint8_t *data, uint16_t length);
+void spi_stop(void);
+void spiStartSend(SPIDriver *spip, size_t n, const void *txbuf);
+
+void gpio_write_pin_low(uint32_t pin);
+void gpio_write_pin_high(uint32_t pin);
@@ -0,0 +1,5 @@
+#pragma once
+
+#include <stdbool.h>
+
+extern bool isLeftHand;
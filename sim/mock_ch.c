@@ -0,0 +1,282 @@
+// mock_ch.c — one emulated core for HLC_RENDER_THREAD (see include/ch.h).
+//
+// The core is the kernel lock plus two flags: lent (the main thread is
+// waiting, so the render thread may run) and running (the render thread
+// is outside any kernel call). When the main thread takes the core back
+// from a running thread it sends SIGUSR1, and the handler parks the thread
+// until the core is lent again. Kernel calls block the signal, so the
+// thread is never parked holding the lock.
+
+#define _GNU_SOURCE  // SCHED_IDLE
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/prctl.h>
+#include <time.h>
+#include "ch.h"
+#include "sim.h"
+#include "hardware/structs/timer.h"
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  wake;
+static sigset_t        stop_set;
+static pthread_t       render;
+static bool            started;
+static bool            lent;        // the main thread waits: the render thread may run
+static bool            running;     // the render thread is between kernel calls
+static bool            blocked;     // the render thread waits for block_ready(block_p)
+static bool          (*block_ready)(void *);
+static void           *block_p;
+static tfunc_t         render_fn;
+static void           *render_arg;
+static virtual_timer_t *timers;
+
+static volatile sig_atomic_t stop_req, stopped;
+static sem_t                 stop_ack, resume;
+
+__attribute__((constructor)) static void ch_init(void) {
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&wake, &attr);
+    sigemptyset(&stop_set);
+    sigaddset(&stop_set, SIGUSR1);
+    sem_init(&stop_ack, 0, 0);
+    sem_init(&resume, 0, 0);
+    prctl(PR_SET_TIMERSLACK, 1);  // wake the main thread on its deadline, not 50 µs late
+}
+
+static bool is_render(void) {
+    return started && pthread_equal(pthread_self(), render);
+}
+
+// ─── The core ───
+static void on_stop(int sig) {
+    if (!stop_req) return;  // a request the thread already answered by blocking
+    int saved = errno;
+    stop_req = 0;
+    stopped  = 1;
+    sem_post(&stop_ack);
+    while (sem_wait(&resume) && errno == EINTR) {}
+    errno = saved;
+}
+
+// Lock held
+static void core_lend(void) {
+    lent = true;
+    if (stopped) {
+        stopped = 0;
+        sem_post(&resume);
+    }
+    pthread_cond_broadcast(&wake);
+}
+
+// Lock held; on return the render thread is parked or blocked
+static void core_take(void) {
+    lent = false;
+    if (!running) return;
+    stop_req = 1;
+    pthread_mutex_unlock(&lock);
+    pthread_kill(render, SIGUSR1);
+    while (sem_wait(&stop_ack) && errno == EINTR) {}
+    pthread_mutex_lock(&lock);
+}
+
+// Render thread, lock held: wait until ready(p) and the core is lent
+static void render_block(bool (*ready)(void *), void *p) {
+    running = false;
+    if (stop_req) {  // the main thread is taking the core back: blocking answers it
+        stop_req = 0;
+        sem_post(&stop_ack);
+    }
+    block_ready = ready;
+    block_p     = p;
+    while (!(lent && ready(p))) {
+        blocked = true;
+        pthread_cond_broadcast(&wake);
+        pthread_cond_wait(&wake, &lock);
+        blocked = false;
+    }
+    running = true;
+}
+
+// Main thread, lock held: lend the core until ready(p) or the deadline (µs
+// on the sim's timer, 0 for none)
+static bool main_wait(bool (*ready)(void *), void *p, uint32_t deadline) {
+    core_lend();
+    bool ok = true;
+    while (!ready(p)) {
+        if (!deadline) {
+            pthread_cond_wait(&wake, &lock);
+            continue;
+        }
+        int32_t left = deadline - timer_hw->timerawl;
+        if (left <= 0) {
+            ok = false;
+            break;
+        }
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        ts.tv_nsec += (left * 1000 + SIM_US_SCALE - 1) / SIM_US_SCALE;
+        ts.tv_sec += ts.tv_nsec / 1000000000;
+        ts.tv_nsec %= 1000000000;
+        pthread_cond_timedwait(&wake, &lock, &ts);
+    }
+    core_take();
+    return ok;
+}
+
+static void kernel_enter(sigset_t *old) {
+    pthread_sigmask(SIG_BLOCK, &stop_set, old);
+    pthread_mutex_lock(&lock);
+}
+
+static void kernel_exit(const sigset_t *old) {
+    pthread_mutex_unlock(&lock);
+    pthread_sigmask(SIG_SETMASK, old, NULL);
+}
+
+// ─── Semaphores and mutexes ───
+static bool sem_free(void *p) {
+    return !((binary_semaphore_t *)p)->taken;
+}
+
+static bool mtx_free(void *p) {
+    return !((mutex_t *)p)->owned;
+}
+
+// Waiting on something nobody has signalled yet
+static bool render_idle(void *p) {
+    return blocked && !block_ready(block_p);
+}
+
+void chBSemSignalI(binary_semaphore_t *bsp) {
+    bsp->taken = false;
+    pthread_cond_broadcast(&wake);
+}
+
+void chBSemResetI(binary_semaphore_t *bsp, bool taken) {
+    bsp->taken = taken;
+}
+
+void chBSemSignal(binary_semaphore_t *bsp) {
+    sigset_t old;
+    kernel_enter(&old);
+    chBSemSignalI(bsp);
+    kernel_exit(&old);
+}
+
+msg_t chBSemWait(binary_semaphore_t *bsp) {
+    return chBSemWaitTimeout(bsp, 0);
+}
+
+msg_t chBSemWaitTimeout(binary_semaphore_t *bsp, sysinterval_t timeout) {
+    sigset_t old;
+    bool     ok = true;
+    kernel_enter(&old);
+    if (is_render()) {
+        render_block(sem_free, bsp);
+    } else if (bsp->taken) {
+        ok = main_wait(sem_free, bsp, timeout ? (timer_hw->timerawl + timeout) | 1 : 0);
+    }
+    if (ok) bsp->taken = true;
+    kernel_exit(&old);
+    return ok ? MSG_OK : MSG_TIMEOUT;
+}
+
+void chMtxLock(mutex_t *mp) {
+    sigset_t old;
+    kernel_enter(&old);
+    if (is_render()) {
+        render_block(mtx_free, mp);
+    } else if (mp->owned) {
+        main_wait(mtx_free, mp, 0);  // the owner runs until it lets go
+    }
+    mp->owned = true;
+    kernel_exit(&old);
+}
+
+bool chMtxTryLock(mutex_t *mp) {
+    sigset_t old;
+    kernel_enter(&old);
+    bool ok = !mp->owned;
+    if (ok) mp->owned = true;
+    kernel_exit(&old);
+    return ok;
+}
+
+void chMtxUnlock(mutex_t *mp) {
+    sigset_t old;
+    kernel_enter(&old);
+    mp->owned = false;
+    pthread_cond_broadcast(&wake);
+    kernel_exit(&old);
+}
+
+// ─── Threads ───
+static bool always(void *p) {
+    return true;
+}
+
+static void *render_entry(void *p) {
+    // Below the main thread, as on the keyboard: when the main thread's
+    // wait times out, the host scheduler switches to it at once
+    struct sched_param sp = {0};
+    pthread_setschedparam(pthread_self(), SCHED_IDLE, &sp);
+    sigset_t old;
+    kernel_enter(&old);
+    render_block(always, NULL);  // not before the core is first lent
+    kernel_exit(&old);
+    render_fn(render_arg);
+    return NULL;
+}
+
+thread_t *chThdCreateStatic(void *wsp, size_t size, tprio_t prio, tfunc_t pf, void *arg) {
+    static thread_t   tp;
+    struct sigaction  sa = {.sa_handler = on_stop, .sa_flags = SA_RESTART};
+    if (started) abort();  // one render thread
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGUSR1, &sa, NULL);
+    render_fn  = pf;
+    render_arg = arg;
+    pthread_mutex_lock(&lock);
+    started = running = true;
+    pthread_create(&render, NULL, render_entry, NULL);
+    while (!blocked) pthread_cond_wait(&wake, &lock);
+    pthread_mutex_unlock(&lock);
+    return &tp;
+}
+
+// ─── Virtual timers ───
+void chVTObjectInit(virtual_timer_t *vtp) {
+    *vtp = (virtual_timer_t){0};
+}
+
+void chVTSetContinuous(virtual_timer_t *vtp, sysinterval_t delay, vtfunc_t vtfunc, void *par) {
+    vtp->period_ms = delay / 1000;
+    vtp->next_ms   = sim_now_ms + vtp->period_ms;
+    vtp->func      = vtfunc;
+    vtp->par       = par;
+    vtp->link      = timers;
+    timers         = vtp;
+}
+
+void sim_vt_run(void) {
+    pthread_mutex_lock(&lock);
+    for (virtual_timer_t *vtp = timers; vtp; vtp = vtp->link) {
+        while ((int32_t)(sim_now_ms - vtp->next_ms) >= 0) {
+            vtp->func(vtp, vtp->par);
+            vtp->next_ms += vtp->period_ms;
+        }
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+void sim_ch_settle(void) {
+    pthread_mutex_lock(&lock);
+    if (started) main_wait(render_idle, NULL, 0);
+    pthread_mutex_unlock(&lock);
+}
@@ -0,0 +1,99 @@
+// mock_qmk.c — host stand-ins for the QMK runtime: virtual clock,
+// scripted WPM, EEPROM, the µs timer and the ring oscillator.
+
+#include "quantum.h"
+#include "eeprom.h"
+#include "hardware/structs/rosc.h"
+#include "hardware/structs/timer.h"
+#include <time.h>
+#include <stdio.h>
+#include "sim.h"
+
+uint32_t sim_now_ms;
+uint8_t  sim_wpm;
+uint32_t sim_last_activity;
+bool     sim_left = true;
+
+layer_state_t layer_state, default_layer_state;
+
+// ─── Clock / input ───
+uint32_t timer_read32(void) { return sim_now_ms; }
+uint32_t timer_elapsed32(uint32_t last) { return sim_now_ms - last; }
+void     wait_ms(uint32_t ms) { sim_now_ms += ms; }
+uint8_t  get_current_wpm(void) { return sim_wpm; }
+uint32_t last_matrix_activity_time(void) { return sim_last_activity; }
+uint32_t last_input_activity_elapsed(void) { return sim_now_ms - sim_last_activity; }
+
+bool    is_keyboard_left(void) { return sim_left; }
+bool    is_keyboard_master(void) { return true; }
+led_t   host_keyboard_led_state(void) { return (led_t){0}; }
+uint8_t get_highest_layer(layer_state_t state) { return state ? 31 - __builtin_clz(state) : 0; }
+
+void    backlight_enable(void) {}
+void    backlight_disable(void) {}
+uint8_t get_backlight_level(void) { return BACKLIGHT_LEVELS; }
+void    backlight_level(uint8_t level) {}
+
+// ─── Microsecond timer ───
+static __thread timer_hw_t timer_regs;  // the render thread reads it too
+
+timer_hw_t *sim_timer(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    timer_regs.timerawl = (uint32_t)((ts.tv_sec * 1000000ull + ts.tv_nsec / 1000) * SIM_US_SCALE +
+                                     sim_counters.spi_wait_ns / 1000);
+    return &timer_regs;
+}
+
+// ─── Ring oscillator ───
+// Deterministic xorshift so runs are repeatable
+static uint32_t  rosc_state = 0x12345678;
+static rosc_hw_t rosc_regs;
+
+rosc_hw_t *sim_rosc(void) {
+    rosc_state ^= rosc_state << 13;
+    rosc_state ^= rosc_state >> 17;
+    rosc_state ^= rosc_state << 5;
+    rosc_regs.randombit = rosc_state & 1;
+    return &rosc_regs;
+}
+
+// ─── EEPROM ───
+static uint8_t eeprom[TOTAL_EEPROM_BYTE_COUNT];
+
+uint8_t  eeprom_read_byte(const uint8_t *addr) { return eeprom[(uintptr_t)addr]; }
+uint16_t eeprom_read_word(const uint16_t *addr) { uint16_t v; memcpy(&v, &eeprom[(uintptr_t)addr], sizeof(v)); return v; }
+uint32_t eeprom_read_dword(const uint32_t *addr) { uint32_t v; memcpy(&v, &eeprom[(uintptr_t)addr], sizeof(v)); return v; }
+void     eeprom_read_block(void *buf, const void *addr, size_t len) { memcpy(buf, &eeprom[(uintptr_t)addr], len); }
+
+bool sim_eeprom_load(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return false;
+    size_t n = fread(eeprom, 1, sizeof(eeprom), f);
+    fclose(f);
+    return n == sizeof(eeprom);
+}
+
+bool sim_eeprom_save(const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (!f) return false;
+    size_t n = fwrite(eeprom, 1, sizeof(eeprom), f);
+    fclose(f);
+    return n == sizeof(eeprom);
+}
+
+void eeprom_write_byte(uint8_t *addr, uint8_t value) {
+    eeprom[(uintptr_t)addr] = value;
+    sim_counters.eeprom_writes++;
+}
+
+void eeprom_update_byte(uint8_t *addr, uint8_t value) {
+    if (eeprom[(uintptr_t)addr] != value) eeprom_write_byte(addr, value);
+}
+
+void eeprom_update_block(const void *buf, void *addr, size_t len) {
+    for (size_t i = 0; i < len; i++) eeprom_update_byte((uint8_t *)addr + i, ((const uint8_t *)buf)[i]);
+}
+
+void eeprom_update_word(uint16_t *addr, uint16_t value) { eeprom_update_block(&value, addr, sizeof(value)); }
+void eeprom_update_dword(uint32_t *addr, uint32_t value) { eeprom_update_block(&value, addr, sizeof(value)); }
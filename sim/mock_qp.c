@@ -0,0 +1,259 @@
+// mock_qp.c — host stand-ins for the Quantum Painter calls used by the
+// display code: an RGB565 surface and an ST7789 panel model that counts
+// every byte it is sent.
+
+#include "qp.h"
+#include "qp_surface.h"
+#include "spi_master.h"
+#include "color.h"
+#include "sim.h"
+
+sim_counters_t sim_counters;
+
+// Viewport state shared by the surface and the panel
+typedef struct {
+    uint16_t  width, height;
+    uint16_t *pixels;
+    uint16_t  left, top, right, bottom;
+    uint16_t  x, y;
+    bool      dirty;                         // surface only: bounds of writes
+    uint16_t  dirty_l, dirty_t, dirty_r, dirty_b;
+} sim_device_t;
+
+static uint16_t     panel_pixels[LCD_WIDTH * LCD_HEIGHT];
+static sim_device_t panel   = {.pixels = panel_pixels};
+static sim_device_t surface;
+
+const uint16_t *sim_panel_pixels(void) {
+    return panel_pixels;
+}
+
+// Same integer HSV conversion as QMK's color.c
+rgb_t hsv_to_rgb_nocie(hsv_t hsv) {
+    rgb_t rgb;
+    if (hsv.s == 0) {
+        rgb.r = rgb.g = rgb.b = hsv.v;
+        return rgb;
+    }
+    uint16_t h = hsv.h, s = hsv.s, v = hsv.v;
+    uint8_t  region = h * 6 / 255;
+    uint8_t  rem    = (h * 2 - region * 85) * 3;
+    uint8_t  p      = (v * (255 - s)) >> 8;
+    uint8_t  q      = (v * (255 - ((s * rem) >> 8))) >> 8;
+    uint8_t  t      = (v * (255 - ((s * (255 - rem)) >> 8))) >> 8;
+    switch (region) {
+        case 6:
+        case 0: rgb.r = v; rgb.g = t; rgb.b = p; break;
+        case 1: rgb.r = q; rgb.g = v; rgb.b = p; break;
+        case 2: rgb.r = p; rgb.g = v; rgb.b = t; break;
+        case 3: rgb.r = p; rgb.g = q; rgb.b = v; break;
+        case 4: rgb.r = t; rgb.g = p; rgb.b = v; break;
+        default: rgb.r = v; rgb.g = p; rgb.b = q; break;
+    }
+    return rgb;
+}
+
+static uint16_t native_color(uint8_t hue, uint8_t sat, uint8_t val) {
+    rgb_t    rgb = hsv_to_rgb_nocie((hsv_t){hue, sat, val});
+    uint16_t c   = ((rgb.r & 0xF8) << 8) | ((rgb.g & 0xFC) << 3) | (rgb.b >> 3);
+    return __builtin_bswap16(c);
+}
+
+// ─── Devices ───
+painter_device_t qp_st7789_make_spi_device(uint16_t panel_width, uint16_t panel_height, uint32_t chip_select_pin, uint32_t dc_pin, uint32_t reset_pin, uint16_t spi_divisor, int spi_mode) {
+    panel.width  = panel_width;
+    panel.height = panel_height;
+    return &panel;
+}
+
+painter_device_t qp_make_rgb565_surface(uint16_t panel_width, uint16_t panel_height, void *buffer) {
+    surface.width  = panel_width;
+    surface.height = panel_height;
+    surface.pixels = buffer;
+    return &surface;
+}
+
+bool qp_init(painter_device_t device, painter_rotation_t rotation) { return true; }
+bool qp_power(painter_device_t device, bool power_on) { return true; }
+bool qp_clear(painter_device_t device) { return true; }
+void qp_set_viewport_offsets(painter_device_t device, uint16_t offset_x, uint16_t offset_y) {}
+
+bool qp_flush(painter_device_t device) {
+    if (device == &panel) sim_counters.flushes++;
+    return true;
+}
+
+// ─── Pixel streaming ───
+static void set_window(sim_device_t *d, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    d->left = d->x = left;
+    d->top = d->y = top;
+    d->right      = right;
+    d->bottom     = bottom;
+}
+
+// Like QP's surface, only qp_* writes are tracked; direct framebuffer
+// writes never reach the panel through qp_surface_draw
+static void mark_dirty(uint16_t x, uint16_t y) {
+    if (!surface.dirty) {
+        surface.dirty_l = surface.dirty_r = x;
+        surface.dirty_t = surface.dirty_b = y;
+        surface.dirty = true;
+        return;
+    }
+    if (x < surface.dirty_l) surface.dirty_l = x;
+    if (x > surface.dirty_r) surface.dirty_r = x;
+    if (y < surface.dirty_t) surface.dirty_t = y;
+    if (y > surface.dirty_b) surface.dirty_b = y;
+}
+
+static void stream(sim_device_t *d, const uint16_t *px, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        if (d->x < d->width && d->y < d->height) {
+            d->pixels[d->y * d->width + d->x] = px[i];
+            if (d == &surface) mark_dirty(d->x, d->y);
+        }
+        if (++d->x > d->right) {
+            d->x = d->left;
+            if (++d->y > d->bottom) d->y = d->top;
+        }
+    }
+}
+
+bool qp_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    // CASET + RASET + RAMWR: 3 command bytes, 8 argument bytes
+    if (device == &panel) {
+        sim_counters.spi_bytes += 11;
+        sim_counters.spi_wait_ns += 11 * SIM_SPI_NS_PER_BYTE;
+    }
+    set_window(device, left, top, right, bottom);
+    return true;
+}
+
+bool qp_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+    if (device == &panel) {
+        sim_counters.spi_bytes += native_pixel_count * sizeof(uint16_t);
+        sim_counters.spi_wait_ns += native_pixel_count * sizeof(uint16_t) * SIM_SPI_NS_PER_BYTE;
+    }
+    stream(device, pixel_data, native_pixel_count);
+    return true;
+}
+
+// Mirrors QP's qp_rect: convert the colour once, then stream it through viewport/pixdata
+bool qp_rect(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom, uint8_t hue, uint8_t sat, uint8_t val, bool filled) {
+    uint16_t buf[64];
+    uint16_t c = native_color(hue, sat, val);
+    for (int i = 0; i < 64; i++) buf[i] = c;
+
+    uint32_t n = (uint32_t)(right - left + 1) * (bottom - top + 1);
+    sim_counters.rect_calls++;
+    sim_counters.rect_pixels += n;
+    qp_viewport(device, left, top, right, bottom);
+    while (n) {
+        uint32_t k = n > 64 ? 64 : n;
+        qp_pixdata(device, buf, k);
+        n -= k;
+    }
+    return true;
+}
+
+// Sends the dirty rectangle (or everything), then marks the surface clean
+bool qp_surface_draw(painter_device_t surface_device, painter_device_t display, uint16_t x, uint16_t y, bool entire_surface) {
+    sim_device_t *s = surface_device;
+    if (!entire_surface && !s->dirty) return true;
+    uint16_t l = entire_surface ? 0 : s->dirty_l, t = entire_surface ? 0 : s->dirty_t;
+    uint16_t r = entire_surface ? s->width - 1 : s->dirty_r, b = entire_surface ? s->height - 1 : s->dirty_b;
+    qp_viewport(display, x + l, y + t, x + r, y + b);
+    for (uint16_t row = t; row <= b; row++)
+        qp_pixdata(display, &s->pixels[row * s->width + l], r - l + 1);
+    s->dirty = false;
+    return true;
+}
+
+// ─── SPI / ST7789 byte model (HLC_ASYNC_FLUSH) ───
+// Commands arrive with DC low, arguments and pixels with DC high.
+// A DMA transfer stays busy for sim_spi_latency polls of SPI_DRIVER.
+SPIDriver        SPID1 = {SPI_READY};
+int              sim_spi_latency = 3;
+sim_panel_mode_t sim_panel_mode;
+
+static bool    dc_high;
+static uint8_t command;
+static uint8_t args[4];
+static uint8_t arg_count;
+static int     busy_polls;
+static bool    batch_sent;   // spiStartSend since spi_start: spi_stop ends a flush
+
+uint16_t sim_panel_visible(uint16_t x, uint16_t y) {
+    if (sim_panel_mode.partial && (y < sim_panel_mode.top || y > sim_panel_mode.bottom)) return 0;
+    uint16_t c = panel_pixels[y * LCD_WIDTH + x];
+    if (!sim_panel_mode.idle) return c;
+    c = __builtin_bswap16(c);
+    c = (c & 0x8000 ? 0xF800 : 0) | (c & 0x0400 ? 0x07E0 : 0) | (c & 0x0010 ? 0x001F : 0);
+    return __builtin_bswap16(c);
+}
+
+SPIDriver *sim_spi_poll(void) {
+    if (SPID1.state == SPI_ACTIVE && --busy_polls <= 0) SPID1.state = SPI_READY;
+    return &SPID1;
+}
+
+void gpio_write_pin_low(uint32_t pin) { dc_high = false; }
+void gpio_write_pin_high(uint32_t pin) { dc_high = true; }
+bool spi_start(uint32_t slave_pin, bool lsb_first, uint8_t mode, uint16_t divisor) { return true; }
+
+// An async batch ends here; panel mode commands also go through spi_stop
+// but send no pixels, so they are not counted
+void spi_stop(void) {
+    if (batch_sent) sim_counters.flushes++;
+    batch_sent = false;
+}
+
+int spi_write(uint8_t data) {
+    sim_counters.spi_bytes++;
+    if (!dc_high) {
+        command   = data;
+        arg_count = 0;
+        switch (command) {
+            case 0x2C: set_window(&panel, panel.left, panel.top, panel.right, panel.bottom); break;  // RAMWR
+            case 0x12: sim_panel_mode.partial = true; break;   // PTLON
+            case 0x13: sim_panel_mode.partial = false; break;  // NORON
+            case 0x38: sim_panel_mode.idle = false; break;     // IDMOFF
+            case 0x39: sim_panel_mode.idle = true; break;      // IDMON
+        }
+        return 0;
+    }
+    if (command == 0x30 && arg_count < 4) {  // PTLAR
+        args[arg_count++] = data;
+        if (arg_count == 4) {
+            sim_panel_mode.top    = (args[0] << 8 | args[1]) - LCD_OFFSET_Y;
+            sim_panel_mode.bottom = (args[2] << 8 | args[3]) - LCD_OFFSET_Y;
+        }
+    }
+    if ((command == 0x2A || command == 0x2B) && arg_count < 4) {
+        args[arg_count++] = data;
+        if (arg_count == 4) {
+            uint16_t start = (args[0] << 8 | args[1]), end = (args[2] << 8 | args[3]);
+            if (command == 0x2A) {
+                panel.left  = start - LCD_OFFSET_X;
+                panel.right = end - LCD_OFFSET_X;
+            } else {
+                panel.top    = start - LCD_OFFSET_Y;
+                panel.bottom = end - LCD_OFFSET_Y;
+            }
+        }
+    }
+    return 0;
+}
+
+int spi_transmit(const uint8_t *data, uint16_t length) {
+    for (uint16_t i = 0; i < length; i++) spi_write(data[i]);
+    return 0;
+}
+
+void spiStartSend(SPIDriver *spip, size_t n, const void *txbuf) {
+    sim_counters.spi_bytes += n;
+    stream(&panel, txbuf, n / sizeof(uint16_t));
+    spip->state = SPI_ACTIVE;
+    busy_polls  = sim_spi_latency;
+    batch_sent  = true;
+}
@@ -0,0 +1,56 @@
+// sim.h — host simulator state shared by the mocks and the frame runner
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    uint64_t rect_calls;     // qp_rect() calls on any device
+    uint64_t rect_pixels;    // pixels filled by qp_rect()
+    uint64_t spi_bytes;      // bytes sent to the panel (commands + pixels)
+    uint64_t spi_wait_ns;    // time the CPU spent sending them (sync flush only)
+    uint64_t flushes;        // qp_flush() calls on the panel, or async batches sent
+    uint64_t eeprom_writes;  // bytes actually written to EEPROM
+} sim_counters_t;
+
+extern sim_counters_t sim_counters;
+
+// The µs timer runs SIM_US_SCALE times faster than the host clock, to stand
+// in for a slower core: budgets like SLICE_US then cut host work about
+// where they would cut it on the RP2040
+#ifndef SIM_US_SCALE
+#    define SIM_US_SCALE 1
+#endif
+
+// A sync panel write holds the CPU for its time on the wire: 128 ns a byte
+// at 62.5 MHz, the RP2040's fastest SPI clock. It is added to the µs timer,
+// so a sliced flush stops after about as many rows as on the keyboard.
+// DMA transfers (HLC_ASYNC_FLUSH) leave the CPU free and are not charged.
+#ifndef SIM_SPI_NS_PER_BYTE
+#    define SIM_SPI_NS_PER_BYTE 128
+#endif
+
+// Virtual clock and scripted inputs, driven by sim_main.c
+extern uint32_t sim_now_ms;
+extern uint8_t  sim_wpm;
+extern uint32_t sim_last_activity;
+extern bool     sim_left;
+
+// EEPROM image file, so a later run boots with this run's saves
+bool sim_eeprom_load(const char *path);
+bool sim_eeprom_save(const char *path);
+
+// Panel contents in native (byte-swapped) RGB565, as the ST7789 holds them
+const uint16_t *sim_panel_pixels(void);
+
+// ST7789 display modes, decoded from the command stream
+typedef struct {
+    bool     partial, idle;
+    uint16_t top, bottom;  // partial area, surface rows
+} sim_panel_mode_t;
+
+extern sim_panel_mode_t sim_panel_mode;
+
+// Pixel as it appears on the glass: black outside the partial area,
+// one bit per channel in idle mode
+uint16_t sim_panel_visible(uint16_t x, uint16_t y);
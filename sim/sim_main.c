@@ -0,0 +1,311 @@
+// sim_main.c — run the tamagotchi on the host under a virtual clock.
+//
+// Links tamagotchi.c and hlc_tft_display.c unchanged against the mocks,
+// drives the display housekeeping task from a scripted WPM timeline and
+// reports what each frame cost: qp_rect calls, pixels filled and bytes
+// sent to the panel. Optionally dumps every frame as a PPM image.
+//
+//   sim [-n frames] [-s script] [-o dir] [-e every] [-p eeprom] [-u secs] [-2] [-c] [-q]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+#include "halcyon.h"
+#include "hlc_tft_display.h"
+#include "hlc_perf.h"
+#include "hlc_journal.h"
+#include "sim.h"
+#ifdef HLC_RENDER_THREAD
+#    include "ch.h"
+#endif
+
+#define SIM_FRAME_MS   100  // one frame of virtual time, matches TICK_MS
+#define SIM_TICK_MS    10   // housekeeping task interval
+#ifndef SIM_PASSES
+#    define SIM_PASSES 4     // housekeeping passes per SIM_TICK_MS, to finish sliced frames
+#endif
+#define SIM_MAX_STEPS  64
+#define SIM_SUSPEND_MS 17   // one pass of QMK's suspend loop
+
+// ─── WPM script ───
+// Each line is "<second> <wpm>"; the WPM holds until the next line and the
+// whole script repeats after its last entry. Lines starting with # are ignored.
+typedef struct {
+    uint32_t at_ms;
+    uint8_t  wpm;
+} sim_step_t;
+
+static sim_step_t script[SIM_MAX_STEPS] = {
+    {0, 80}, {60000, 110}, {120000, 0}, {840000, 0},  // type 2 min, idle 12 min
+};
+static uint8_t script_len = 4;
+
+static bool load_script(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) return false;
+    char     line[128];
+    unsigned sec, wpm;
+    script_len = 0;
+    while (fgets(line, sizeof(line), f) && script_len < SIM_MAX_STEPS) {
+        if (line[0] == '#' || sscanf(line, "%u %u", &sec, &wpm) != 2) continue;
+        script[script_len++] = (sim_step_t){sec * 1000, wpm > 255 ? 255 : wpm};
+    }
+    fclose(f);
+    return script_len > 0;
+}
+
+static uint8_t script_wpm(uint32_t now) {
+    uint32_t period = script[script_len - 1].at_ms;
+    uint32_t t      = period ? now % period : now;
+    uint8_t  wpm    = script[0].wpm;
+    for (uint8_t i = 0; i < script_len && script[i].at_ms <= t; i++) wpm = script[i].wpm;
+    return wpm;
+}
+
+// ─── Main loop passes ───
+// How long each housekeeping pass held the main loop, which is what the
+// display adds to scan jitter. µs on the sim timer, so host time times
+// SIM_US_SCALE; only measured in PERF builds.
+#ifdef HLC_PERF_ENABLE
+#    define PASS_HIST 8192
+
+static struct {
+    uint64_t n, sum, sq;
+    uint32_t max;
+    uint32_t hist[PASS_HIST + 1];  // last: PASS_HIST µs and over
+} pass;
+
+static void pass_record(uint32_t us) {
+    pass.n++;
+    pass.sum += us;
+    pass.sq += (uint64_t)us * us;
+    if (us > pass.max) pass.max = us;
+    pass.hist[us < PASS_HIST ? us : PASS_HIST]++;
+}
+
+static void pass_report(void) {
+    if (!pass.n) return;
+    double   avg = (double)pass.sum / pass.n, var = (double)pass.sq / pass.n - avg * avg;
+    uint64_t seen = 0;
+    uint32_t p99  = 0;
+    while (p99 < PASS_HIST && (seen += pass.hist[p99]) * 100 < pass.n * 99) p99++;
+    printf("pass: %llu housekeeping passes, avg %.1f sd %.1f p99 %u max %u us\n",
+           (unsigned long long)pass.n, avg, var > 0 ? sqrt(var) : 0, p99, pass.max);
+}
+#else
+static inline void pass_record(uint32_t us) {}
+#endif
+
+// Panel writes each pass waited on. They come from the modelled wire time
+// alone, so they are the same on every run. A sliced flush may send one
+// row past the slice, never a second slice: the pump before the keymap
+// draws and the one after share the pass deadline. Only the keymap's half
+// is checked: the Game of Life half sends a whole frame per pass, and the
+// render thread's flush is preempted rather than sliced.
+#define SIM_SLICE_US     400  // the keymap's SLICE_US
+#define SIM_PASS_SPI_MAX (SIM_SLICE_US + (LCD_WIDTH * 2 + 11) * SIM_SPI_NS_PER_BYTE / 1000 + 1)
+
+static uint32_t pass_spi_max;  // µs
+
+// ─── Frame dumps ───
+static bool write_ppm(const char *dir, uint32_t frame) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/frame_%06u.ppm", dir, frame);
+    FILE *f = fopen(path, "wb");
+    if (!f) return false;
+
+    fprintf(f, "P6\n%d %d\n255\n", LCD_WIDTH, LCD_HEIGHT);
+    for (uint32_t i = 0; i < LCD_WIDTH * LCD_HEIGHT; i++) {
+        uint16_t c      = __builtin_bswap16(sim_panel_visible(i % LCD_WIDTH, i / LCD_WIDTH));
+        uint8_t  rgb[3] = {(c >> 11) << 3, ((c >> 5) & 0x3F) << 2, (c & 0x1F) << 3};
+        fwrite(rgb, 1, 3, f);
+    }
+    fclose(f);
+    return true;
+}
+
+// ─── Suspend ───
+// What halcyon.c does: QMK calls suspend_power_down_kb() on every pass of
+// its suspend loop and suspend_wakeup_init_kb() once on wakeup. Returns
+// the EEPROM bytes written meanwhile.
+static uint64_t sim_suspend(uint32_t ms) {
+    uint64_t written = sim_counters.eeprom_writes;
+    for (uint32_t t = 0; t < ms; t += SIM_SUSPEND_MS) {
+        sim_now_ms += SIM_SUSPEND_MS;
+        module_suspend_power_down_kb();
+        suspend_power_down_user();
+        hlc_journal_commit();
+    }
+    module_suspend_wakeup_init_kb();
+    suspend_wakeup_init_user();
+    return sim_counters.eeprom_writes - written;
+}
+
+static void usage(const char *name) {
+    fprintf(stderr,
+            "usage: %s [-n frames] [-s script] [-o dir] [-e every] [-p eeprom] [-u secs] [-2] [-c] [-q]\n"
+            "  -n  frames of %d ms to simulate (default 3000)\n"
+            "  -s  WPM script file, lines of \"<second> <wpm>\"\n"
+            "  -o  write panel contents as PPM images into dir\n"
+            "  -e  only dump every Nth frame (default 1)\n"
+            "  -p  EEPROM image: loaded at boot if present, saved at exit (a power cut)\n"
+            "  -u  suspend for secs halfway through; fails if that writes more than one save\n"
+            "  -2  run as the right half's second display (Game of Life)\n"
+            "  -c  print per-frame counters as CSV\n"
+            "  -q  only print the summary\n",
+            name, SIM_FRAME_MS);
+}
+
+int main(int argc, char **argv) {
+    uint32_t    frames = 3000, every = 1, suspend_s = 0;
+    const char *out_dir = NULL, *eeprom_path = NULL;
+    bool        csv = false, quiet = false, second = false;
+    int         opt;
+
+    while ((opt = getopt(argc, argv, "n:s:o:e:p:u:2cqh")) != -1) {
+        switch (opt) {
+            case 'n': frames = strtoul(optarg, NULL, 10); break;
+            case 's':
+                if (!load_script(optarg)) {
+                    fprintf(stderr, "cannot read script %s\n", optarg);
+                    return 2;
+                }
+                break;
+            case 'o': out_dir = optarg; break;
+            case 'e': every = strtoul(optarg, NULL, 10); break;
+            case 'p': eeprom_path = optarg; break;
+            case 'u': suspend_s = strtoul(optarg, NULL, 10); break;
+            case '2': second = true; break;
+            case 'c': csv = true; break;
+            case 'q': quiet = true; break;
+            default: usage(argv[0]); return opt == 'h' ? 0 : 2;
+        }
+    }
+    if (!every) every = 1;
+
+    if (eeprom_path) sim_eeprom_load(eeprom_path);
+    sim_now_ms = 1000;
+    sim_left   = !second;
+    module_post_init_kb();
+
+    sim_counters_t start = sim_counters, prev = sim_counters;
+    uint64_t       max_bytes = 0;
+    uint32_t       mismatches = 0;
+    uint32_t       partial_frames = 0, idle_frames = 0;
+    uint64_t       suspend_writes = 0;
+
+    if (csv) printf("frame,ms,wpm,rect_calls,rect_pixels,spi_bytes,flushes\n");
+    uint32_t       key_budget = 0;  // keystrokes owed, in 1/60000 of a press
+    for (uint32_t f = 0; f < frames; f++) {
+        if (suspend_s && f == frames / 2) suspend_writes = sim_suspend(suspend_s * 1000);
+        for (uint32_t t = 0; t < SIM_FRAME_MS; t += SIM_TICK_MS) {
+            sim_now_ms += SIM_TICK_MS;
+#ifdef HLC_RENDER_THREAD
+            sim_vt_run();
+#endif
+            sim_wpm = script_wpm(sim_now_ms);
+            // Five keystrokes per word, delivered through the keymap's hook
+            key_budget += sim_wpm * 5 * SIM_TICK_MS;
+            for (; key_budget >= 60000; key_budget -= 60000) {
+                keyrecord_t record = {.event = {.pressed = true, .time = (uint16_t)sim_now_ms}};
+                sim_last_activity  = sim_now_ms;
+                process_record_user(0, &record);
+            }
+            if (!sim_wpm) key_budget = 0;
+            for (int p = 0; p < SIM_PASSES; p++) {
+                uint32_t t0   = hlc_perf_now();
+                uint64_t wait = sim_counters.spi_wait_ns;
+                display_module_housekeeping_task_kb(second);
+                pass_record(hlc_perf_now() - t0);
+                wait = (sim_counters.spi_wait_ns - wait) / 1000;
+                if (!second && wait > pass_spi_max) pass_spi_max = wait;
+            }
+        }
+
+#ifdef HLC_RENDER_THREAD
+        // Let the render thread finish its frame: not counted as a pass
+        sim_ch_settle();
+#endif
+        // Let any background flush land before looking at the panel
+        hlc_flush_wait();
+        if (memcmp(sim_panel_pixels(), lcd_surface_fb, LCD_WIDTH * LCD_HEIGHT * sizeof(uint16_t))) {
+            if (!mismatches && !quiet) fprintf(stderr, "frame %u: panel differs from surface\n", f);
+            mismatches++;
+        }
+        // Idle mode must only be on while the visible band loses no colour
+        if (sim_panel_mode.idle) {
+            partial_frames++;
+            idle_frames++;
+            for (uint16_t y = sim_panel_mode.top; y <= sim_panel_mode.bottom; y++) {
+                for (uint16_t x = 0; x < LCD_WIDTH; x++) {
+                    if (sim_panel_visible(x, y) == sim_panel_pixels()[y * LCD_WIDTH + x]) continue;
+                    if (!mismatches && !quiet) fprintf(stderr, "frame %u: idle mode shows wrong colours\n", f);
+                    mismatches++;
+                    y = sim_panel_mode.bottom;
+                    break;
+                }
+            }
+        } else if (sim_panel_mode.partial) {
+            partial_frames++;
+        }
+
+        uint64_t bytes = sim_counters.spi_bytes - prev.spi_bytes;
+        if (bytes > max_bytes) max_bytes = bytes;
+        if (csv)
+            printf("%u,%u,%u,%llu,%llu,%llu,%llu\n", f, sim_now_ms, sim_wpm,
+                   (unsigned long long)(sim_counters.rect_calls - prev.rect_calls),
+                   (unsigned long long)(sim_counters.rect_pixels - prev.rect_pixels),
+                   (unsigned long long)bytes,
+                   (unsigned long long)(sim_counters.flushes - prev.flushes));
+        if (out_dir && f % every == 0 && !write_ppm(out_dir, f)) {
+            fprintf(stderr, "cannot write frames to %s\n", out_dir);
+            return 2;
+        }
+        prev = sim_counters;
+    }
+
+    double n = frames ? frames : 1;
+    fprintf(csv ? stderr : stdout,
+            "%u frames (%u s virtual)\n"
+            "  qp_rect calls/frame  %.1f\n"
+            "  pixels filled/frame  %.0f\n"
+            "  bytes flushed/frame  %.0f (max %llu)\n"
+            "  panel flushes        %llu\n"
+            "  longest pass on SPI  %u us\n"
+            "  eeprom bytes written %llu\n"
+            "  partial/idle frames  %u/%u\n"
+            "  panel mismatches     %u\n",
+            frames, frames * SIM_FRAME_MS / 1000,
+            (sim_counters.rect_calls - start.rect_calls) / n,
+            (sim_counters.rect_pixels - start.rect_pixels) / n,
+            (sim_counters.spi_bytes - start.spi_bytes) / n, (unsigned long long)max_bytes,
+            (unsigned long long)(sim_counters.flushes - start.flushes), pass_spi_max,
+            (unsigned long long)sim_counters.eeprom_writes,
+            partial_frames, idle_frames, mismatches);
+    // One save record at most: the state when suspend started
+    if (suspend_s) {
+        fprintf(csv ? stderr : stdout, "  suspended %u s, eeprom bytes written %llu\n", suspend_s,
+                (unsigned long long)suspend_writes);
+        if (suspend_writes > HLC_JOURNAL_SLOT_SIZE) {
+            fprintf(stderr, "suspend wrote more than one save\n");
+            mismatches++;
+        }
+    }
+#ifndef HLC_RENDER_THREAD
+    if (pass_spi_max > SIM_PASS_SPI_MAX) {
+        fprintf(stderr, "a pass spent more than one slice on the panel\n");
+        mismatches++;
+    }
+#endif
+    if (eeprom_path && !sim_eeprom_save(eeprom_path)) {
+        fprintf(stderr, "cannot write %s\n", eeprom_path);
+        return 2;
+    }
+    if (!quiet) hlc_perf_report();
+#ifdef HLC_PERF_ENABLE
+    if (!quiet) pass_report();
+#endif
+    return mismatches ? 1 : 0;
+}
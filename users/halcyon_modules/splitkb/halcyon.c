@@ -3,6 +3,10 @@
 
 #include QMK_KEYBOARD_H
 #include "halcyon.h"
+#include "hlc_perf.h"
+#include "hlc_loop.h"
+#include "hlc_journal.h"
+#include "hlc_core1.h"
 #include "transactions.h"
 #include "split_util.h"
 #include "_wait.h"
@@ -72,6 +76,9 @@ void suspend_power_down_kb(void) {
     module_suspend_power_down_kb();
 
     suspend_power_down_user();
+
+    // Nothing is drawn while suspended, so staged saves can be written now
+    hlc_journal_commit();
 }
 
 void suspend_wakeup_init_kb(void) {
@@ -92,6 +99,15 @@ void keyboard_post_init_kb(void) {
 }
 
 void housekeeping_task_kb(void) {
+    // One housekeeping call per main loop pass: count the pass, then charge
+    // each hook below its share of it (no-op unless HLC_PERF_ENABLE)
+    hlc_loop_pass();
+    uint32_t t = hlc_loop_now();
+
+    // Wake core1 for its next pass, ending any hold a flash write took
+    // since the last one (no-op unless HLC_CORE1_ENABLE)
+    hlc_core1_task();
+
     if (is_keyboard_master()) {
         static bool synced = false;
 
@@ -104,12 +120,15 @@ void housekeeping_task_kb(void) {
                 synced = true;
             }
         }
+        t = hlc_loop_lap(HLC_HOOK_SYNC, t);
 
         display_module_housekeeping_task_kb(false); // Is master so can never be the second display
+        t = hlc_loop_lap(HLC_HOOK_DISPLAY, t);
     }
 
     if (!is_keyboard_master()) {
         display_module_housekeeping_task_kb(module_master == hlc_tft_display);
+        t = hlc_loop_lap(HLC_HOOK_DISPLAY, t);
     }
 
     // Backlight feature
@@ -122,13 +141,23 @@ void housekeeping_task_kb(void) {
             backlight_suspend();
         }
     }
+    t = hlc_loop_lap(HLC_HOOK_BACKLIGHT, t);
 
     module_housekeeping_task_kb();
+    t = hlc_loop_lap(HLC_HOOK_MODULE, t);
+
+    // Periodic profiler and main-loop reports on the console (no-op unless
+    // HLC_PERF_ENABLE); the loop report starts a new window after printing
+    hlc_perf_task();
+    hlc_loop_task();
+    t = hlc_loop_now();
 
     housekeeping_task_user();
+    hlc_loop_lap(HLC_HOOK_USER, t);
 }
 
 report_mouse_t pointing_device_task_combined_kb(report_mouse_t left_report, report_mouse_t right_report) {
+    uint32_t t = hlc_loop_now();
     // Only runs on master
     // Fixes the following bug: If master is right and master is NOT a cirque trackpad, the inputs would be inverted.
     if(module != hlc_cirque_trackpad && !is_keyboard_left()) {
@@ -137,7 +166,9 @@ report_mouse_t pointing_device_task_combined_kb(report_mouse_t left_report, repo
         left_report.x = -x;
         left_report.y = -y;
     }
-    return pointing_device_task_combined_user(left_report, right_report);
+    report_mouse_t report = pointing_device_task_combined_user(left_report, right_report);
+    hlc_loop_lap(HLC_HOOK_POINTING, t);
+    return report;
 }
 
 // Kyria
@@ -18,6 +18,8 @@ extern module_t module_master;
 bool module_post_init_kb(void);
 bool module_housekeeping_task_kb(void);
 bool display_module_housekeeping_task_kb(bool second_display);
+void module_suspend_power_down_kb(void);
+void module_suspend_wakeup_init_kb(void);
 bool module_post_init_user(void);
 bool module_housekeeping_task_user(void);
 bool display_module_housekeeping_task_user(bool second_display);
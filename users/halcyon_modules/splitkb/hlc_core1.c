@@ -0,0 +1,175 @@
+// Copyright 2024 splitkb.com (support@splitkb.com)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include QMK_KEYBOARD_H
+#include "hlc_core1.h"
+
+#ifdef HLC_CORE1_ENABLE
+
+#    include "hardware/structs/psm.h"
+#    include "hardware/structs/scb.h"
+#    include "hardware/structs/sio.h"
+#    include "hardware/structs/timer.h"
+#    include "wear_leveling_internal.h"
+
+static uint32_t core1_stack[HLC_CORE1_STACK_SIZE / sizeof(uint32_t)] __attribute__((aligned(8)));
+static void (*core1_entry)(void);
+static bool core1_running = false;
+
+// Park handshake: core0 raises park_req, core1 answers with park_ack from
+// RAM and drops it again once park_req is gone
+static uint32_t park_req   = 0;      // written by core0
+static uint32_t park_ack   = 0;      // written by core1
+static uint8_t  park_depth = 0;      // nested parks, core0 only
+static bool     park_held  = false;  // hold to drop at the next task, core0 only
+
+static inline bool core0_with_core1(void) {
+    return core1_running && sio_hw->cpuid == 0;
+}
+
+// ─── Launch ───
+static void fifo_push(uint32_t v) {
+    while (!(sio_hw->fifo_st & SIO_FIFO_ST_RDY_BITS)) {}
+    sio_hw->fifo_wr = v;
+    __asm volatile("sev");
+}
+
+static uint32_t fifo_pop(void) {
+    while (!(sio_hw->fifo_st & SIO_FIFO_ST_VLD_BITS)) {}
+    return sio_hw->fifo_rd;
+}
+
+static void core1_main(void) {
+    core1_entry();
+    for (;;) hlc_core1_safe_point();  // entry returned: stay parkable
+}
+
+// Reset core1 and hand it to the bootrom's launch protocol: each word is
+// echoed back, and any mismatch starts the sequence over
+bool hlc_core1_launch(void (*entry)(void)) {
+    if (core1_running || sio_hw->cpuid != 0) return false;
+    core1_entry = entry;
+
+    hw_set_bits(&psm_hw->frce_off, PSM_FRCE_OFF_PROC1_BITS);
+    while (!(psm_hw->frce_off & PSM_FRCE_OFF_PROC1_BITS)) {}
+    hw_clear_bits(&psm_hw->frce_off, PSM_FRCE_OFF_PROC1_BITS);
+
+    const uint32_t seq[] = {
+        0, 0, 1, scb_hw->vtor, (uintptr_t)&core1_stack[sizeof(core1_stack) / sizeof(core1_stack[0])], (uintptr_t)core1_main,
+    };
+    uint8_t i = 0;
+    while (i < sizeof(seq) / sizeof(seq[0])) {
+        if (!seq[i]) {
+            while (sio_hw->fifo_st & SIO_FIFO_ST_VLD_BITS) (void)sio_hw->fifo_rd;
+            __asm volatile("sev");
+        }
+        fifo_push(seq[i]);
+        i = fifo_pop() == seq[i] ? i + 1 : 0;
+    }
+    core1_running = true;
+    return true;
+}
+
+bool hlc_core1_running(void) {
+    return core1_running;
+}
+
+// ─── Park ───
+// Runs from RAM, so core1 keeps running while the flash is off. Nothing
+// in here may call out: only inline atomics and WFE.
+static void __attribute__((noinline, section(".time_critical.hlc_core1_park"))) park_spin(void) {
+    __atomic_store_n(&park_ack, 1, __ATOMIC_RELEASE);
+    while (__atomic_load_n(&park_req, __ATOMIC_ACQUIRE)) __asm volatile("wfe");
+    __atomic_store_n(&park_ack, 0, __ATOMIC_RELEASE);
+}
+
+// Core1: park here if core0 asked. Call between units of work, never
+// with anything half written that core0 reads while core1 is parked.
+void hlc_core1_safe_point(void) {
+    if (__atomic_load_n(&park_req, __ATOMIC_ACQUIRE)) park_spin();
+}
+
+// Core0: returns once core1 is parked. Nests; each park needs its release.
+void hlc_core1_park(void) {
+    if (!core0_with_core1() || park_depth++) return;
+    __atomic_store_n(&park_req, 1, __ATOMIC_RELEASE);
+    __asm volatile("sev");  // core1 may be in hlc_core1_idle()
+    while (!__atomic_load_n(&park_ack, __ATOMIC_ACQUIRE)) {}
+}
+
+// Waits for core1 to leave the spin, so a park right after this one
+// cannot take the old acknowledgement for a new one
+void hlc_core1_release(void) {
+    if (!core0_with_core1() || !park_depth || --park_depth) return;
+    __atomic_store_n(&park_req, 0, __ATOMIC_RELEASE);
+    __asm volatile("sev");
+    while (__atomic_load_n(&park_ack, __ATOMIC_ACQUIRE)) {}
+}
+
+// Park now and release at the next hlc_core1_task(), for flash writes
+// in code that does not release on its own
+void hlc_core1_hold(void) {
+    if (!core0_with_core1() || park_held) return;
+    hlc_core1_park();
+    park_held = true;
+}
+
+// Core1: sleep until core0 sends an event. Core0 sends one every
+// housekeeping pass and with every park, so a core1 loop with nothing due
+// wakes at the main loop's rate instead of spinning.
+void hlc_core1_idle(void) {
+    __asm volatile("wfe");
+}
+
+void hlc_core1_task(void) {
+    if (!core0_with_core1()) return;
+    __asm volatile("sev");
+    if (!park_held) return;
+    park_held = false;
+    hlc_core1_release();
+}
+
+// ─── Flash writes ───
+// rules.mk links QMK's wear-leveling backing store through these, so every
+// EEPROM write parks core1, whoever starts it. The hold is taken before the
+// flash goes off and outlasts the rest of the write sequence.
+bool __real_backing_store_unlock(void);
+bool __real_backing_store_erase(void);
+bool __real_backing_store_write(uint32_t address, backing_store_int_t value);
+bool __real_backing_store_write_bulk(uint32_t address, backing_store_int_t *values, size_t item_count);
+
+bool __wrap_backing_store_unlock(void) {
+    hlc_core1_hold();
+    return __real_backing_store_unlock();
+}
+
+bool __wrap_backing_store_erase(void) {
+    hlc_core1_hold();
+    return __real_backing_store_erase();
+}
+
+bool __wrap_backing_store_write(uint32_t address, backing_store_int_t value) {
+    hlc_core1_hold();
+    return __real_backing_store_write(address, value);
+}
+
+bool __wrap_backing_store_write_bulk(uint32_t address, backing_store_int_t *values, size_t item_count) {
+    hlc_core1_hold();
+    return __real_backing_store_write_bulk(address, values, item_count);
+}
+
+// ─── Time ───
+// The 64-bit µs timer read high-low-high, so no state is kept and either
+// core may call this. Not the same epoch as timer_read32().
+uint32_t hlc_core1_ms(void) {
+    uint32_t hi = timer_hw->timerawh, lo;
+    for (;;) {
+        lo           = timer_hw->timerawl;
+        uint32_t hi2 = timer_hw->timerawh;
+        if (hi2 == hi) break;
+        hi = hi2;
+    }
+    return (uint32_t)((((uint64_t)hi << 32) | lo) / 1000);
+}
+
+#endif
@@ -0,0 +1,86 @@
+// Copyright 2024 splitkb.com (support@splitkb.com)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// The RP2040's second core. Enable with `HLC_CORE1_ENABLE = yes` in the
+// keymap rules.mk; without it every call below compiles away. The option
+// is experimental and has not been run on a keyboard yet.
+//
+// Core1 runs code from flash like core0 does, and the EEPROM emulation
+// turns the flash off while it writes. Core1 therefore has to sit in RAM
+// for every write: the code it runs calls hlc_core1_safe_point() between
+// units of work, and core0 parks it around anything that writes:
+//
+//   hlc_core1_park();                 // returns once core1 spins in RAM
+//   eeprom_update_block(...);
+//   hlc_core1_release();
+//
+// Writes QMK starts on its own (VIA, eeconfig keycodes, deferred settings)
+// are caught at the wear-leveling backing store, which rules.mk wraps at
+// link time: the first write takes a hold, a park that lasts until the
+// next hlc_core1_task(). halcyon.c runs that once per housekeeping pass.
+//
+// ChibiOS runs on core0 only: code on core1 must not call into the kernel,
+// the HAL drivers or timer_read32(), which keeps state of its own.
+
+#ifndef HLC_CORE1_STACK_SIZE
+#    define HLC_CORE1_STACK_SIZE 4096  // bytes
+#endif
+
+// ─── Seqlock ───
+// One writer, any number of readers, nobody waits on anyone: the writer
+// bumps the sequence to odd, writes, bumps it to even; a reader retries
+// when the sequence was odd or moved while it copied.
+//
+//   hlc_seqlock_write_begin(&lock);  snap = next;  hlc_seqlock_write_end(&lock);
+//
+//   uint32_t s;
+//   do { s = hlc_seqlock_read_begin(&lock); copy = snap; } while (hlc_seqlock_read_retry(&lock, s));
+typedef struct {
+    uint32_t seq;
+} hlc_seqlock_t;
+
+static inline void hlc_seqlock_write_begin(hlc_seqlock_t *l) {
+    __atomic_store_n(&l->seq, l->seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static inline void hlc_seqlock_write_end(hlc_seqlock_t *l) {
+    __atomic_store_n(&l->seq, l->seq + 1, __ATOMIC_RELEASE);
+}
+
+static inline uint32_t hlc_seqlock_read_begin(const hlc_seqlock_t *l) {
+    uint32_t s;
+    while ((s = __atomic_load_n(&l->seq, __ATOMIC_ACQUIRE)) & 1) {}
+    return s;
+}
+
+static inline bool hlc_seqlock_read_retry(const hlc_seqlock_t *l, uint32_t s) {
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&l->seq, __ATOMIC_RELAXED) != s;
+}
+
+#ifdef HLC_CORE1_ENABLE
+bool     hlc_core1_launch(void (*entry)(void));
+bool     hlc_core1_running(void);
+void     hlc_core1_park(void);
+void     hlc_core1_release(void);
+void     hlc_core1_hold(void);
+void     hlc_core1_safe_point(void);
+void     hlc_core1_idle(void);
+void     hlc_core1_task(void);
+uint32_t hlc_core1_ms(void);  // ms since boot, safe on either core
+#else
+static inline bool     hlc_core1_launch(void (*entry)(void)) { return false; }
+static inline bool     hlc_core1_running(void) { return false; }
+static inline void     hlc_core1_park(void) {}
+static inline void     hlc_core1_release(void) {}
+static inline void     hlc_core1_hold(void) {}
+static inline void     hlc_core1_safe_point(void) {}
+static inline void     hlc_core1_idle(void) {}
+static inline void     hlc_core1_task(void) {}
+#endif
@@ -2,7 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "split_util.h"
-#include "atomic_util.h"
+#include "hardware/structs/sio.h"
 
 #ifdef SPLIT_KEYBOARD
 #    define ROWS_PER_HAND (MATRIX_ROWS / 2)
@@ -36,6 +36,13 @@ static SPLIT_MUTABLE_COL pin_t col_pins[MATRIX_COLS]   = MATRIX_COL_PINS;
 #    endif // MATRIX_COL_PINS
 #endif
 
+// Rows and columns as SIO bit positions, filled once the right half has
+// its pins: a whole row is then one gpio_in load and a few shifts. Pins
+// GP0-29 only, so bit 31 is never a column and stands in for NO_PIN.
+static uint32_t row_bits[ROWS_PER_HAND];
+static uint32_t col_mask = 0;
+static uint8_t  col_shift[MATRIX_COLS];
+
 void matrix_init_kb(void) {
 
     gpio_set_pin_input_high(HLC_ENCODER_BUTTON);
@@ -55,74 +62,65 @@ void matrix_init_kb(void) {
                 }
         #    endif
     }
-}
-
-static inline void setPinOutput_writeLow(pin_t pin) {
-    ATOMIC_BLOCK_FORCEON {
-        gpio_set_pin_output(pin);
-        gpio_write_pin_low(pin);
-    }
-}
 
-static inline void setPinOutput_writeHigh(pin_t pin) {
-    ATOMIC_BLOCK_FORCEON {
-        gpio_set_pin_output(pin);
-        gpio_write_pin_high(pin);
+    uint32_t row_mask = 0;
+    for (uint8_t i = 0; i < ROWS_PER_HAND; i++) {
+        row_bits[i] = row_pins[i] != NO_PIN ? 1u << row_pins[i] : 0;
+        row_mask |= row_bits[i];
     }
-}
-
-static inline void setPinInputHigh_atomic(pin_t pin) {
-    ATOMIC_BLOCK_FORCEON {
-        gpio_set_pin_input_high(pin);
+    for (uint8_t i = 0; i < MATRIX_COLS; i++) {
+        col_shift[i] = col_pins[i] != NO_PIN ? col_pins[i] : 31;
+        col_mask |= col_pins[i] != NO_PIN ? 1u << col_pins[i] : 0;
     }
-}
 
-static inline uint8_t readMatrixPin(pin_t pin) {
-    if (pin != NO_PIN) {
-        return (gpio_read_pin(pin) == MATRIX_INPUT_PRESSED_STATE) ? 0 : 1;
-    } else {
-        return 1;
-    }
+    // QMK left the rows unselected and on SIO. Selecting a row is then a
+    // single write to the SIO set/clear registers, which are atomic, so no
+    // pin is reconfigured and no interrupts are masked during a scan.
+#ifdef MATRIX_UNSELECT_DRIVE_HIGH
+    sio_hw->gpio_set    = row_mask;
+    sio_hw->gpio_oe_set = row_mask;
+#else
+    sio_hw->gpio_clr = row_mask;  // output latch low; the pull-up holds the row while it is an input
+#endif
 }
 
-// THIS FUNCTION IS CHANGED, removed NO_PIN check
-static bool select_row(uint8_t row) {
-    pin_t pin = row_pins[row];
-    setPinOutput_writeLow(pin);
-    return true;
+// THESE FUNCTIONS ARE CHANGED: SIO writes instead of pin reconfiguration
+static inline void select_row(uint8_t row) {
+#ifdef MATRIX_UNSELECT_DRIVE_HIGH
+    sio_hw->gpio_clr = row_bits[row];
+#else
+    sio_hw->gpio_oe_set = row_bits[row];
+#endif
 }
 
-static void unselect_row(uint8_t row) {
-    pin_t pin = row_pins[row];
-    if (pin != NO_PIN) {
-#            ifdef MATRIX_UNSELECT_DRIVE_HIGH
-        setPinOutput_writeHigh(pin);
-#            else
-        setPinInputHigh_atomic(pin);
-#            endif
-    }
+static inline void unselect_row(uint8_t row) {
+#ifdef MATRIX_UNSELECT_DRIVE_HIGH
+    sio_hw->gpio_set = row_bits[row];
+#else
+    sio_hw->gpio_oe_clr = row_bits[row];
+#endif
 }
 
 void matrix_read_cols_on_row(matrix_row_t current_matrix[], uint8_t current_row) {
     // Start with a clear matrix row
     matrix_row_t current_row_value = 0;
 
-    if (!select_row(current_row)) { // Select row
-        return;                     // skip NO_PIN row
-    }
+    select_row(current_row);
     matrix_output_select_delay();
 
+    // Every column, and the encoder button, in one load
+    uint32_t in = sio_hw->gpio_in;
+
     // ↓↓↓ THIS HAS BEEN ADDED/CHANGED
     if (current_row == (ROWS_PER_HAND - 1)) {
-        current_row_value |= ((!gpio_read_pin(HLC_ENCODER_BUTTON)) & 1) << 0;
+        current_row_value |= ((~in >> HLC_ENCODER_BUTTON) & 1) << 0;
     } else {
-        // For each col...
-        matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
-        for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++, row_shifter <<= 1) {
-            uint8_t pin_state = readMatrixPin(col_pins[col_index]);
-
-            // Populate the matrix row with the state of the col pin
-            current_row_value |= pin_state ? 0 : row_shifter;
+        uint32_t pressed = (MATRIX_INPUT_PRESSED_STATE ? in : ~in) & col_mask;
+        // Nothing held is the common case: skip the shuffle
+        if (pressed) {
+            for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++) {
+                current_row_value |= (matrix_row_t)((pressed >> col_shift[col_index]) & 1) << col_index;
+            }
         }
     }
     // ↑↑↑ THIS HAS BEEN ADDED/CHANGED
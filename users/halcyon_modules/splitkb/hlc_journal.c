@@ -0,0 +1,150 @@
+// Copyright 2024 splitkb.com (support@splitkb.com)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "quantum.h"
+#include "eeprom.h"
+#include "hlc_journal.h"
+#include "hlc_core1.h"
+
+#ifdef HLC_JOURNAL_ENABLE
+
+_Static_assert(HLC_JOURNAL_SLOTS > HLC_JOURNAL_TYPES, "journal needs a free slot beside one live record per type");
+_Static_assert(HLC_JOURNAL_ADDR + HLC_JOURNAL_SIZE <= TOTAL_EEPROM_BYTE_COUNT, "journal past the end of EEPROM");
+#if defined(VIA_ENABLE) && defined(DYNAMIC_KEYMAP_EEPROM_MAX_ADDR)
+_Static_assert(DYNAMIC_KEYMAP_EEPROM_MAX_ADDR < HLC_JOURNAL_ADDR, "dynamic keymap macros run into the journal");
+#endif
+
+#define NO_SLOT 0xFF
+
+typedef struct {
+    uint8_t len;   // 0 = nothing
+    uint8_t slot;  // slot holding the newest committed record, NO_SLOT if none
+    uint8_t data[HLC_JOURNAL_DATA_MAX];
+} journal_entry_t;
+
+static bool            journal_ready = false;
+static uint16_t        journal_seq   = 0;  // sequence number of the next record
+static uint8_t         journal_head  = 0;  // slot the next record goes to
+static journal_entry_t newest[HLC_JOURNAL_TYPES];   // newest record per type, committed or staged
+static bool            staged[HLC_JOURNAL_TYPES];   // newest[] not yet written
+
+// CRC-16/CCITT-FALSE
+static uint16_t crc16(const uint8_t *p, uint8_t n) {
+    uint16_t crc = 0xFFFF;
+    while (n--) {
+        crc ^= (uint16_t)*p++ << 8;
+        for (int i = 0; i < 8; i++) crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
+
+// One pass over every slot: newest valid record per type, and the head
+// after the highest sequence number (compared with wrap-around)
+static void journal_init(void) {
+    uint16_t newest_seq[HLC_JOURNAL_TYPES];
+    for (uint8_t t = 0; t < HLC_JOURNAL_TYPES; t++) newest[t].slot = NO_SLOT;
+    bool     any = false;
+    uint16_t top = 0;
+    for (uint8_t s = 0; s < HLC_JOURNAL_SLOTS; s++) {
+        uint8_t slot[HLC_JOURNAL_SLOT_SIZE];
+        eeprom_read_block(slot, (const void *)(uintptr_t)(HLC_JOURNAL_ADDR + s * HLC_JOURNAL_SLOT_SIZE), sizeof(slot));
+        uint8_t type = slot[2], len = slot[3];
+        if (type < 1 || type > HLC_JOURNAL_TYPES || !len || len > HLC_JOURNAL_DATA_MAX) continue;
+        if (crc16(slot, 4 + len) != (slot[4 + len] | slot[5 + len] << 8)) continue;
+
+        uint16_t seq = slot[0] | slot[1] << 8;
+        if (!any || (int16_t)(seq - top) > 0) {
+            top          = seq;
+            journal_head = (s + 1) % HLC_JOURNAL_SLOTS;
+        }
+        journal_entry_t *e = &newest[type - 1];
+        if (!e->len || (int16_t)(seq - newest_seq[type - 1]) > 0) {
+            newest_seq[type - 1] = seq;
+            e->len               = len;
+            e->slot              = s;
+            memcpy(e->data, &slot[4], len);
+        }
+        any = true;
+    }
+    journal_seq   = any ? top + 1 : 0;
+    journal_ready = true;
+}
+
+// Copy the newest record of type into data (up to max bytes); returns its
+// length, 0 if there is none
+uint8_t hlc_journal_latest(uint8_t type, void *data, uint8_t max) {
+    if (!journal_ready) journal_init();
+    if (type < 1 || type > HLC_JOURNAL_TYPES) return 0;
+    const journal_entry_t *e = &newest[type - 1];
+    memcpy(data, e->data, e->len < max ? e->len : max);
+    return e->len;
+}
+
+// Stage a record; a later append of the same type replaces it, and one
+// equal to the newest record of its type is dropped. Nothing is written here.
+void hlc_journal_append(uint8_t type, const void *data, uint8_t len) {
+    if (!journal_ready) journal_init();
+    if (type < 1 || type > HLC_JOURNAL_TYPES || !len || len > HLC_JOURNAL_DATA_MAX) return;
+    journal_entry_t *e = &newest[type - 1];
+    if (e->len == len && !memcmp(e->data, data, len)) return;
+    e->len = len;
+    memcpy(e->data, data, len);
+    staged[type - 1] = true;
+}
+
+bool hlc_journal_pending(void) {
+    for (uint8_t t = 0; t < HLC_JOURNAL_TYPES; t++)
+        if (staged[t]) return true;
+    return false;
+}
+
+// Slot holds the only committed copy of some type's newest record
+static bool slot_live(uint8_t s) {
+    for (uint8_t t = 0; t < HLC_JOURNAL_TYPES; t++)
+        if (newest[t].slot == s) return true;
+    return false;
+}
+
+// Write at the next slot that no live record occupies, so a rarely saved
+// type is never pushed out by a frequent one and a torn write always
+// leaves the previous record of its type intact
+static void journal_write(uint8_t type) {
+    journal_entry_t *e = &newest[type - 1];
+    while (slot_live(journal_head)) journal_head = (journal_head + 1) % HLC_JOURNAL_SLOTS;
+
+    uint8_t slot[HLC_JOURNAL_SLOT_SIZE];
+    slot[0] = journal_seq & 0xFF;
+    slot[1] = journal_seq >> 8;
+    slot[2] = type;
+    slot[3] = e->len;
+    memcpy(&slot[4], e->data, e->len);
+    uint16_t crc     = crc16(slot, 4 + e->len);
+    slot[4 + e->len] = crc & 0xFF;
+    slot[5 + e->len] = crc >> 8;
+    eeprom_update_block(slot, (void *)(uintptr_t)(HLC_JOURNAL_ADDR + journal_head * HLC_JOURNAL_SLOT_SIZE), 6 + e->len);
+
+    e->slot      = journal_head;
+    journal_seq++;
+    journal_head = (journal_head + 1) % HLC_JOURNAL_SLOTS;
+}
+
+// Write one staged record. Call where a flash write cannot stall a frame;
+// core1, when running, is parked for the write and cannot append meanwhile.
+void hlc_journal_task(void) {
+    for (uint8_t t = 0; t < HLC_JOURNAL_TYPES; t++) {
+        if (!staged[t]) continue;
+        hlc_core1_park();
+        staged[t] = false;
+        journal_write(t + 1);
+        hlc_core1_release();
+        return;
+    }
+}
+
+// Write everything staged, now (suspend)
+void hlc_journal_commit(void) {
+    while (hlc_journal_pending()) hlc_journal_task();
+}
+
+#endif
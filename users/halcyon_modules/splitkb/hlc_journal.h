@@ -0,0 +1,62 @@
+// Copyright 2024 splitkb.com (support@splitkb.com)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Small append-only save store in EEPROM (flash-emulated on the RP2040).
+//
+// The region is split into fixed slots used round-robin, so repeated saves
+// spread over all of them instead of rewriting one address. Each record is
+// [seq:2][type:1][len:1][data:len][crc16:2]; only those bytes are written.
+// Boot reads the region once; the newest valid record of a type wins, so a
+// torn write just falls back to the previous one.
+//
+//   len = hlc_journal_latest(TYPE, buf, sizeof(buf));  // at init
+//   hlc_journal_append(TYPE, buf, len);                // any time, RAM only
+//   hlc_journal_task();                                // between frames: writes
+//
+// Keymaps opt in with `HLC_JOURNAL_ENABLE = yes` in rules.mk; without it
+// the calls below compile away and nothing is reserved.
+//
+// The region sits at the top of EEPROM. With VIA/Vial the dynamic keymap
+// macros fill EEPROM up to DYNAMIC_KEYMAP_EEPROM_MAX_ADDR, so the keymap
+// config.h must end them below the journal. That only shortens the macro
+// buffer: the keymap stays at its address, and keymaps saved by older
+// builds still read back.
+
+#ifndef HLC_JOURNAL_SLOT_SIZE
+#    define HLC_JOURNAL_SLOT_SIZE 32
+#endif
+#ifndef HLC_JOURNAL_TYPES
+#    define HLC_JOURNAL_TYPES 4  // record types 1..HLC_JOURNAL_TYPES
+#endif
+
+#if defined(HLC_JOURNAL_ENABLE) && defined(VIA_ENABLE) && !defined(HLC_JOURNAL_ADDR) && !defined(DYNAMIC_KEYMAP_EEPROM_MAX_ADDR)
+#    error "hlc_journal with VIA needs DYNAMIC_KEYMAP_EEPROM_MAX_ADDR (TOTAL_EEPROM_BYTE_COUNT - HLC_JOURNAL_SIZE - 1) in config.h: the top of EEPROM holds dynamic keymap macros"
+#endif
+#ifndef HLC_JOURNAL_SIZE
+#    define HLC_JOURNAL_SIZE 256
+#endif
+#ifndef HLC_JOURNAL_ADDR
+#    define HLC_JOURNAL_ADDR (TOTAL_EEPROM_BYTE_COUNT - HLC_JOURNAL_SIZE)
+#endif
+
+#define HLC_JOURNAL_SLOTS    (HLC_JOURNAL_SIZE / HLC_JOURNAL_SLOT_SIZE)
+#define HLC_JOURNAL_DATA_MAX (HLC_JOURNAL_SLOT_SIZE - 6)
+
+#ifdef HLC_JOURNAL_ENABLE
+uint8_t hlc_journal_latest(uint8_t type, void *data, uint8_t max);
+void    hlc_journal_append(uint8_t type, const void *data, uint8_t len);
+bool    hlc_journal_pending(void);
+void    hlc_journal_task(void);
+void    hlc_journal_commit(void);
+#else
+static inline uint8_t hlc_journal_latest(uint8_t type, void *data, uint8_t max) { return 0; }
+static inline void    hlc_journal_append(uint8_t type, const void *data, uint8_t len) {}
+static inline bool    hlc_journal_pending(void) { return false; }
+static inline void    hlc_journal_task(void) {}
+static inline void    hlc_journal_commit(void) {}
+#endif
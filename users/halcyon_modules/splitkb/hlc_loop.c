@@ -0,0 +1,135 @@
+// Copyright 2024 splitkb.com (support@splitkb.com)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include QMK_KEYBOARD_H
+#include "hlc_loop.h"
+
+#ifdef HLC_PERF_ENABLE
+
+static const char *const hook_names[HLC_HOOKS] = {
+    "sync", "display", "backlight", "module", "user", "pointing",
+};
+
+// Counts since the last report; a report starts a new window
+static struct {
+    uint32_t start, last;   // µs: first and latest pass of the window
+    uint32_t passes;        // passes seen, including the first
+    uint32_t pass_min, pass_max;
+    uint64_t pass_sq;       // sum of squared pass times, for the jitter
+    uint32_t hist[HLC_LOOP_BUCKETS];
+    uint32_t hook_us[HLC_HOOKS];
+    uint32_t hook_max[HLC_HOOKS];
+} loop;
+
+// Called once per main loop pass: the time since the previous call is one
+// full pass, scan and USB included
+void hlc_loop_pass(void) {
+    uint32_t now = hlc_us_now();
+    if (loop.passes) {
+        uint32_t us = now - loop.last;
+        if (us > loop.pass_max) loop.pass_max = us;
+        if (us < loop.pass_min || loop.passes == 1) loop.pass_min = us;
+        loop.pass_sq += (uint64_t)us * us;
+        uint8_t b = us < 32 ? 0 : 32 - __builtin_clz(us) - 5;
+        loop.hist[b < HLC_LOOP_BUCKETS ? b : HLC_LOOP_BUCKETS - 1]++;
+    } else {
+        loop.start = now;
+    }
+    loop.last = now;
+    loop.passes++;
+}
+
+// Charge now - start to hook and return now, so hooks chain back to back
+uint32_t hlc_loop_lap(uint8_t hook, uint32_t start) {
+    uint32_t now = hlc_us_now();
+    if (hook < HLC_HOOKS) {
+        uint32_t us = now - start;
+        loop.hook_us[hook] += us;
+        if (us > loop.hook_max[hook]) loop.hook_max[hook] = us;
+    }
+    return now;
+}
+
+static uint32_t isqrt64(uint64_t v) {
+    uint64_t r = 0, bit = (uint64_t)1 << 62;
+    while (bit > v) bit >>= 2;
+    while (bit) {
+        if (v >= r + bit) {
+            v -= r + bit;
+            r = (r >> 1) + bit;
+        } else {
+            r >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)r;
+}
+
+void hlc_loop_stats(hlc_loop_stats_t *out) {
+    out->window_us = loop.last - loop.start;
+    out->passes    = loop.passes ? loop.passes - 1 : 0;
+    out->pass_min  = loop.pass_min;
+    out->pass_max  = loop.pass_max;
+    out->pass_sd   = 0;
+    if (out->passes) {
+        // E[x²] - E[x]², in µs²
+        uint64_t mean = out->window_us / out->passes;
+        uint64_t sq   = loop.pass_sq / out->passes;
+        out->pass_sd  = sq > mean * mean ? isqrt64(sq - mean * mean) : 0;
+    }
+    memcpy(out->hist, loop.hist, sizeof(out->hist));
+    memcpy(out->hook_us, loop.hook_us, sizeof(out->hook_us));
+    memcpy(out->hook_max, loop.hook_max, sizeof(out->hook_max));
+}
+
+// The next pass starts a fresh window, so the pass that printed the report
+// is not counted as a slow one
+void hlc_loop_reset(void) {
+    memset(&loop, 0, sizeof(loop));
+}
+
+static void print_share(const char *name, uint32_t us, uint32_t max, uint32_t window) {
+    uint32_t permille = window ? (uint32_t)((uint64_t)us * 1000 / window) : 0;
+    uprintf("loop: %-9s %8lu %6lu %3lu.%lu%%\n", name, (unsigned long)us,
+            (unsigned long)max, (unsigned long)(permille / 10), (unsigned long)(permille % 10));
+}
+
+void hlc_loop_report(void) {
+    hlc_loop_stats_t s;
+    hlc_loop_stats(&s);
+    if (!s.passes || !s.window_us) return;
+
+    uprintf("loop: %lu scans/s, pass avg %lu sd %lu min %lu max %lu us\n",
+            (unsigned long)((uint64_t)s.passes * 1000000 / s.window_us),
+            (unsigned long)(s.window_us / s.passes), (unsigned long)s.pass_sd,
+            (unsigned long)s.pass_min, (unsigned long)s.pass_max);
+    static const char *const buckets[HLC_LOOP_BUCKETS] = {
+        "<32", "<64", "<128", "<256", "<512", "<1m", "<2m", "<4m", "<8m", "<16m", "16m+",
+    };
+    uprintf("loop: pass us");
+    for (uint8_t i = 0; i < HLC_LOOP_BUCKETS; i++) uprintf(" %5s", buckets[i]);
+    uprintf("\nloop: passes ");
+    for (uint8_t i = 0; i < HLC_LOOP_BUCKETS; i++) uprintf(" %5lu", (unsigned long)s.hist[i]);
+    uprintf("\n");
+
+    uprintf("loop: hook            us    max  share\n");
+    uint32_t hooks = 0;
+    for (uint8_t i = 0; i < HLC_HOOKS; i++) {
+        hooks += s.hook_us[i];
+        print_share(hook_names[i], s.hook_us[i], s.hook_max[i], s.window_us);
+    }
+    // Scan, debounce, split transport, USB: everything outside the hooks
+    print_share("qmk", hooks < s.window_us ? s.window_us - hooks : 0, 0, s.window_us);
+}
+
+void hlc_loop_task(void) {
+#    if HLC_PERF_REPORT_MS > 0
+    static uint32_t last_report = 0;
+    if (timer_elapsed32(last_report) < HLC_PERF_REPORT_MS) return;
+    last_report = timer_read32();
+    hlc_loop_report();
+    hlc_loop_reset();
+#    endif
+}
+
+#endif
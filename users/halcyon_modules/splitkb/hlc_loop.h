@@ -0,0 +1,68 @@
+// Copyright 2024 splitkb.com (support@splitkb.com)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hlc_perf.h"
+
+// Main-loop counters: how often the matrix is scanned, how long one pass of
+// QMK's main loop takes, and how much of that the Halcyon hooks spend.
+// Built in with HLC_PERF_ENABLE, alongside the phase profiler.
+//
+// QMK scans the matrix once per main loop pass and runs housekeeping once
+// per pass, so halcyon.c calls hlc_loop_pass() first thing in housekeeping
+// and times each hook with a lap:
+//
+//   uint32_t t = hlc_loop_now();
+//   display_module_housekeeping_task_kb(false);  t = hlc_loop_lap(HLC_HOOK_DISPLAY, t);
+//
+// Whatever the hooks do not account for is QMK's own work: matrix scan,
+// debounce, split transport, USB reports.
+
+enum {
+    HLC_HOOK_SYNC,      // MODULE_SYNC transaction to the other half
+    HLC_HOOK_DISPLAY,   // display module housekeeping (drawing, flush)
+    HLC_HOOK_BACKLIGHT, // backlight timeout
+    HLC_HOOK_MODULE,    // module_housekeeping_task_kb
+    HLC_HOOK_USER,      // housekeeping_task_user (keymap)
+    HLC_HOOK_POINTING,  // pointing_device_task_combined_user
+    HLC_HOOKS
+};
+
+// Pass time histogram: bucket 0 is under 32 µs, each next one doubles,
+// the last holds everything from 16 ms up
+#define HLC_LOOP_BUCKETS 11
+
+typedef struct {
+    uint32_t window_us;     // length of the window the counts cover
+    uint32_t passes;        // main loop passes = matrix scans
+    uint32_t pass_min;      // µs, shortest pass
+    uint32_t pass_max;      // µs, longest pass
+    uint32_t pass_sd;       // µs, standard deviation of pass time: scan jitter
+    uint32_t hist[HLC_LOOP_BUCKETS];
+    uint32_t hook_us[HLC_HOOKS];
+    uint32_t hook_max[HLC_HOOKS];  // µs, longest single call
+} hlc_loop_stats_t;
+
+#ifdef HLC_PERF_ENABLE
+static inline uint32_t hlc_loop_now(void) {
+    return hlc_us_now();
+}
+
+void     hlc_loop_pass(void);
+uint32_t hlc_loop_lap(uint8_t hook, uint32_t start);
+void     hlc_loop_stats(hlc_loop_stats_t *out);
+void     hlc_loop_reset(void);
+void     hlc_loop_report(void);
+void     hlc_loop_task(void);
+#else
+static inline uint32_t hlc_loop_now(void) { return 0; }
+static inline void     hlc_loop_pass(void) {}
+static inline uint32_t hlc_loop_lap(uint8_t hook, uint32_t start) { return 0; }
+static inline void     hlc_loop_stats(hlc_loop_stats_t *out) {}
+static inline void     hlc_loop_reset(void) {}
+static inline void     hlc_loop_report(void) {}
+static inline void     hlc_loop_task(void) {}
+#endif
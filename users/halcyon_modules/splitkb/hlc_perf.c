@@ -0,0 +1,121 @@
+// Copyright 2024 splitkb.com (support@splitkb.com)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include QMK_KEYBOARD_H
+#include "hlc_perf.h"
+
+#ifdef HLC_PERF_ENABLE
+
+typedef struct {
+    const char *name;
+    uint32_t    count, min, max;
+    uint64_t    sum;                     // µs; 32 bits wrap after 71 minutes
+    uint16_t    ring[HLC_PERF_SAMPLES];  // µs, saturated at 65535
+    uint16_t    head;
+} perf_phase_t;
+
+static perf_phase_t phases[HLC_PERF_PHASES];
+
+void hlc_perf_register(uint8_t phase, const char *name) {
+    if (phase < HLC_PERF_PHASES) phases[phase].name = name;
+}
+
+void hlc_perf_record(uint8_t phase, uint32_t us) {
+    if (phase >= HLC_PERF_PHASES) return;
+    perf_phase_t *p = &phases[phase];
+    if (!p->count || us < p->min) p->min = us;
+    if (us > p->max) p->max = us;
+    if (p->count == UINT32_MAX) {  // keep the average, at half the weight
+        p->count /= 2;
+        p->sum /= 2;
+    }
+    p->sum += us;
+    p->count++;
+    p->ring[p->head] = us > UINT16_MAX ? UINT16_MAX : us;
+    p->head = (p->head + 1) & (HLC_PERF_SAMPLES - 1);
+}
+
+// Record now - start for phase and return now, so phases chain back to back
+uint32_t hlc_perf_lap(uint8_t phase, uint32_t start) {
+    uint32_t now = hlc_perf_now();
+    hlc_perf_record(phase, now - start);
+    return now;
+}
+
+bool hlc_perf_stats(uint8_t phase, hlc_perf_stats_t *out) {
+    if (phase >= HLC_PERF_PHASES || !phases[phase].count) return false;
+    const perf_phase_t *p = &phases[phase];
+
+    // Insertion sort a copy of the ring; only runs when a report is asked for
+    uint16_t n = p->count < HLC_PERF_SAMPLES ? p->count : HLC_PERF_SAMPLES;
+    uint16_t sorted[HLC_PERF_SAMPLES];
+    for (uint16_t i = 0; i < n; i++) {
+        uint16_t v = p->ring[i], j = i;
+        for (; j > 0 && sorted[j - 1] > v; j--) sorted[j] = sorted[j - 1];
+        sorted[j] = v;
+    }
+
+    out->count = p->count;
+    out->min   = p->min;
+    out->avg   = (uint32_t)(p->sum / p->count);
+    out->max   = p->max;
+    out->p99   = sorted[(n * 99 + 99) / 100 - 1];
+    return true;
+}
+
+void hlc_perf_reset(void) {
+    for (uint8_t i = 0; i < HLC_PERF_PHASES; i++) {
+        const char *name = phases[i].name;
+        memset(&phases[i], 0, sizeof(phases[i]));
+        phases[i].name = name;
+    }
+}
+
+void hlc_perf_report(void) {
+    hlc_perf_stats_t s;
+    uprintf("perf: phase        n    min    avg    max    p99 (us)\n");
+    for (uint8_t i = 0; i < HLC_PERF_PHASES; i++) {
+        if (!phases[i].name || !hlc_perf_stats(i, &s)) continue;
+        uprintf("perf: %-8s %6lu %6lu %6lu %6lu %6lu\n", phases[i].name,
+                (unsigned long)s.count, (unsigned long)s.min, (unsigned long)s.avg,
+                (unsigned long)s.max, (unsigned long)s.p99);
+    }
+}
+
+void hlc_perf_task(void) {
+#    if HLC_PERF_REPORT_MS > 0
+    static uint32_t last_report = 0;
+    if (timer_elapsed32(last_report) < HLC_PERF_REPORT_MS) return;
+    last_report = timer_read32();
+    hlc_perf_report();
+#    endif
+}
+
+#    ifdef VIA_ENABLE
+// ─── Raw HID query ───
+// Request:  [HLC_PERF_HID_ID, phase, reset]
+// Response: [HLC_PERF_HID_ID, phase, status, count, min, avg, max, p99, name...]
+// A non-zero reset byte clears every phase after the reply is filled.
+// Values are little-endian uint32; status is 0 when the phase has samples.
+// VIA echoes the buffer back to the host after this returns.
+void raw_hid_receive_kb(uint8_t *data, uint8_t length) {
+    if (data[0] != HLC_PERF_HID_ID || length < 32) {
+        data[0] = 0xFF;  // id_unhandled
+        return;
+    }
+
+    hlc_perf_stats_t s     = {0};
+    uint8_t          phase = data[1];
+    bool             reset = data[2];
+    bool             ok    = hlc_perf_stats(phase, &s);
+    uint32_t         vals[] = {s.count, s.min, s.avg, s.max, s.p99};
+
+    data[2] = ok ? 0 : 1;
+    memcpy(&data[3], vals, sizeof(vals));
+    memset(&data[23], 0, length - 23);
+    if (ok && phases[phase].name) strncpy((char *)&data[23], phases[phase].name, length - 24);
+    if (reset) hlc_perf_reset();
+}
+#    endif
+
+#endif
@@ -0,0 +1,67 @@
+// Copyright 2024 splitkb.com (support@splitkb.com)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Microsecond phase profiler. Enable with `#define HLC_PERF_ENABLE` in the
+// keymap config.h; without it every call below compiles away.
+//
+//   uint32_t t = hlc_perf_now();
+//   update_game();  t = hlc_perf_lap(PERF_UPDATE, t);
+//   draw_frame();   t = hlc_perf_lap(PERF_DRAW, t);
+//
+// Samples land in a per-phase ring; min/avg/max/p99 are computed on demand
+// and reported over the QMK console (CONSOLE_ENABLE) and raw HID (RAW_ENABLE).
+
+#ifndef HLC_PERF_PHASES
+#    define HLC_PERF_PHASES 12
+#endif
+#ifndef HLC_PERF_SAMPLES
+#    define HLC_PERF_SAMPLES 128  // per phase ring, power of two
+#endif
+#ifndef HLC_PERF_REPORT_MS
+#    define HLC_PERF_REPORT_MS 5000  // console report interval, 0 = never
+#endif
+#ifndef HLC_PERF_HID_ID
+#    define HLC_PERF_HID_ID 0xA0  // raw HID command byte, outside the VIA/Vial range
+#endif
+
+typedef struct {
+    uint32_t count;  // samples since last reset
+    uint32_t min, avg, max;  // µs, over all samples since last reset
+    uint32_t p99;    // µs, over the last HLC_PERF_SAMPLES samples
+} hlc_perf_stats_t;
+
+#include "hardware/structs/timer.h"
+
+// The RP2040's free-running 1 µs timer. Always available: time-sliced work
+// checks its budget against it whether or not the profiler is built in.
+static inline uint32_t hlc_us_now(void) {
+    return timer_hw->timerawl;
+}
+
+#ifdef HLC_PERF_ENABLE
+static inline uint32_t hlc_perf_now(void) {
+    return hlc_us_now();
+}
+
+void     hlc_perf_register(uint8_t phase, const char *name);
+void     hlc_perf_record(uint8_t phase, uint32_t us);
+uint32_t hlc_perf_lap(uint8_t phase, uint32_t start);
+bool     hlc_perf_stats(uint8_t phase, hlc_perf_stats_t *out);
+void     hlc_perf_reset(void);
+void     hlc_perf_report(void);
+void     hlc_perf_task(void);
+#else
+static inline uint32_t hlc_perf_now(void) { return 0; }
+static inline void     hlc_perf_register(uint8_t phase, const char *name) {}
+static inline void     hlc_perf_record(uint8_t phase, uint32_t us) {}
+static inline uint32_t hlc_perf_lap(uint8_t phase, uint32_t start) { return 0; }
+static inline bool     hlc_perf_stats(uint8_t phase, hlc_perf_stats_t *out) { return false; }
+static inline void     hlc_perf_reset(void) {}
+static inline void     hlc_perf_report(void) {}
+static inline void     hlc_perf_task(void) {}
+#endif
@@ -0,0 +1,72 @@
+// Copyright 2024 splitkb.com (support@splitkb.com)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "hlc_life.h"
+#include "hlc_random.h"
+
+// Random grid, alive_pct percent of cells alive; everything marked changed
+void hlc_life_seed(hlc_life_t *life, uint8_t alive_pct) {
+    uint32_t threshold = (uint32_t)(((uint64_t)alive_pct << 32) / 100);
+    for (int y = 0; y < HLC_LIFE_H; y++) {
+        uint32_t row = 0;
+        for (int x = 0; x < HLC_LIFE_W; x++) {
+            if (hlc_random() < threshold) row |= 1UL << x;
+        }
+        life->rows[y]    = row;
+        life->changed[y] = HLC_LIFE_MASK;
+    }
+}
+
+// a + b + c per bit lane: sum bit and carry bit
+static inline void full_add(uint32_t a, uint32_t b, uint32_t c, uint32_t *sum, uint32_t *carry) {
+    uint32_t t = a ^ b;
+    *sum       = t ^ c;
+    *carry     = (a & b) | (t & c);
+}
+
+// One generation for every cell at once. Each row's eight neighbour
+// bitboards are summed with a bit-sliced adder tree, so every bit lane
+// holds its own neighbour count as bits (s0, s1, s2|s3).
+void hlc_life_step(hlc_life_t *life) {
+    uint32_t up = 0;  // previous row, before this step
+    for (int y = 0; y < HLC_LIFE_H; y++) {
+        uint32_t mid  = life->rows[y];
+        uint32_t down = y + 1 < HLC_LIFE_H ? life->rows[y + 1] : 0;
+
+        // Neighbours above, beside and below, each as a 2-bit column sum
+        uint32_t su, cu, sd, cd;
+        full_add(up << 1, up, up >> 1, &su, &cu);
+        full_add(down << 1, down, down >> 1, &sd, &cd);
+        uint32_t sm = (mid << 1) ^ (mid >> 1);
+        uint32_t cm = (mid << 1) & (mid >> 1);
+
+        // Add the three partial sums: ones, twos, fours
+        uint32_t s0, k1, t0, t1;
+        full_add(su, sm, sd, &s0, &k1);
+        full_add(cu, cm, cd, &t0, &t1);
+        uint32_t s1 = t0 ^ k1;
+        uint32_t c2 = t0 & k1;
+
+        // Alive next if count is 3, or 2 and already alive; 4+ sets t1 or c2
+        uint32_t next = s1 & ~(t1 | c2) & (s0 | mid) & HLC_LIFE_MASK;
+
+        life->changed[y] = next ^ mid;
+        life->rows[y]    = next;
+        up               = mid;
+    }
+}
+
+// Random size x size patch at a random position
+void hlc_life_cluster(hlc_life_t *life, uint8_t size) {
+    int x = hlc_random_below(HLC_LIFE_W - size);
+    int y = hlc_random_below(HLC_LIFE_H - size);
+
+    for (int dy = 0; dy < size; dy++) {
+        for (int dx = 0; dx < size; dx++) {
+            uint32_t bit = 1UL << (x + dx);
+            if (hlc_random() & 1) life->rows[y + dy] |= bit;
+            else            life->rows[y + dy] &= ~bit;
+            life->changed[y + dy] |= bit;
+        }
+    }
+}
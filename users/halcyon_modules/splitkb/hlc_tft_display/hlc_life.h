@@ -0,0 +1,27 @@
+// Copyright 2024 splitkb.com (support@splitkb.com)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Game of Life for the second display, one 32-bit word per grid row.
+// Bit x of rows[y] is cell (x, y); cells beyond the edges are dead.
+
+#define HLC_LIFE_W 27
+#define HLC_LIFE_H 48
+#define HLC_LIFE_MASK ((1UL << HLC_LIFE_W) - 1)
+
+typedef struct {
+    uint32_t rows[HLC_LIFE_H];
+    uint32_t changed[HLC_LIFE_H];  // cells that flipped in the last step/seed/cluster
+} hlc_life_t;
+
+void hlc_life_seed(hlc_life_t *life, uint8_t alive_pct);
+void hlc_life_step(hlc_life_t *life);
+void hlc_life_cluster(hlc_life_t *life, uint8_t size);
+
+static inline bool hlc_life_alive(const hlc_life_t *life, uint8_t x, uint8_t y) {
+    return (life->rows[y] >> x) & 1;
+}
@@ -0,0 +1,59 @@
+// Copyright 2024 splitkb.com (support@splitkb.com)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "hlc_random.h"
+
+#include "hardware/structs/rosc.h"
+
+hlc_random_t hlc_rng = {{0x9E3779B9, 0x243F6A88, 0xB7E15162, 0x6A09E667}};
+
+static uint32_t pool;           // von Neumann output bits, newest in bit 0
+static uint8_t  pool_bits;
+static uint8_t  pool_words;     // words stirred so far, saturates at 2
+
+// murmur3 finaliser: every input bit affects every output bit
+static uint32_t mix32(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x85EBCA6B;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35;
+    x ^= x >> 16;
+    return x;
+}
+
+// Fold one word into all four state words; never leaves the state all zero
+static void stir(uint32_t word) {
+    for (int i = 0; i < 4; i++) {
+        hlc_rng.s[i] ^= mix32(word + 0x9E3779B9 * (i + 1));
+    }
+    if (!(hlc_rng.s[0] | hlc_rng.s[1] | hlc_rng.s[2] | hlc_rng.s[3])) hlc_rng.s[0] = 1;
+    // Step past the fresh state so the first outputs are well mixed
+    for (int i = 0; i < 8; i++) hlc_random();
+}
+
+// Deterministic seed (timer at boot, fixed in the simulator); the
+// entropy pool stirs in real randomness on top as it fills
+void hlc_random_seed(uint32_t seed) {
+    stir(seed);
+}
+
+// Called from housekeeping. The ROSC bit is biased and neighbouring
+// reads are correlated, so take it in pairs and keep only 01/10 (von
+// Neumann), then hash every full word before it reaches the state.
+void hlc_entropy_task(void) {
+    for (int i = 0; i < HLC_ENTROPY_PAIRS; i++) {
+        uint32_t a = rosc_hw->randombit & 1;
+        uint32_t b = rosc_hw->randombit & 1;
+        if (a == b) continue;
+        pool = (pool << 1) | a;
+        if (++pool_bits < 32) continue;
+
+        stir(pool);
+        pool_bits = 0;
+        if (pool_words < 2) pool_words++;
+    }
+}
+
+bool hlc_entropy_ready(void) {
+    return pool_words >= 2;
+}
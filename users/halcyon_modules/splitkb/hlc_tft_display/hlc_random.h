@@ -0,0 +1,58 @@
+// Copyright 2024 splitkb.com (support@splitkb.com)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Random numbers for the display apps.
+//
+// hlc_random() is xoshiro128**: four words of state, shifts, rotates and
+// one multiply, all 32-bit so it stays cheap on the M0+. Its state is
+// seeded and stirred from an entropy pool that hlc_entropy_task() fills
+// with ring oscillator bits a few at a time, without ever waiting.
+
+// ROSC bit pairs sampled per hlc_entropy_task() call
+#ifndef HLC_ENTROPY_PAIRS
+#    define HLC_ENTROPY_PAIRS 4
+#endif
+
+typedef struct {
+    uint32_t s[4];
+} hlc_random_t;
+
+extern hlc_random_t hlc_rng;
+
+void hlc_random_seed(uint32_t seed);
+void hlc_entropy_task(void);
+bool hlc_entropy_ready(void);  // at least 64 collected bits stirred into hlc_rng
+
+static inline uint32_t hlc_random_rotl(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+static inline uint32_t hlc_random(void) {
+    uint32_t *s      = hlc_rng.s;
+    uint32_t  result = hlc_random_rotl(s[1] * 5, 7) * 9;
+    uint32_t  t      = s[1] << 9;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = hlc_random_rotl(s[3], 11);
+    return result;
+}
+
+// Uniform in [0, n), n > 0. Multiply-shift with rejection of the few
+// low products that would favour some results, so unlike rand() % n
+// there is no bias; the division only runs on the rare retry path.
+static inline uint32_t hlc_random_below(uint32_t n) {
+    uint64_t m = (uint64_t)hlc_random() * n;
+    if ((uint32_t)m < n) {
+        uint32_t floor = -n % n;
+        while ((uint32_t)m < floor) m = (uint64_t)hlc_random() * n;
+    }
+    return m >> 32;
+}
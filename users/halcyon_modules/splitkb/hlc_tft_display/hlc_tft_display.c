@@ -3,8 +3,19 @@
 
 #include "halcyon.h"
 #include "hlc_tft_display.h"
+#include "hlc_life.h"
+#include "hlc_random.h"
+#include "hlc_perf.h"
+#include "hlc_core1.h"
+#include "hlc_journal.h"
+#include "spi_master.h"
+#ifdef HLC_RENDER_THREAD
+#    include <ch.h>
+#endif
 
-#include "hardware/structs/rosc.h"
+#if defined(HLC_RENDER_THREAD) && defined(HLC_CORE1_ENABLE)
+#    error "HLC_RENDER_THREAD and HLC_CORE1_ENABLE are alternatives: pick one"
+#endif
 
 #ifndef HLC_DISABLE_DEFAULT_DISPLAY
 // Fonts mono2
@@ -33,7 +44,8 @@ static painter_font_handle_t Retron27_underline;
 static painter_image_handle_t layer_number;
 #endif
 
-static uint8_t lcd_surface_fb[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(135, 240, 16)];
+// Word aligned so sprite blitters can address it as native RGB565 pixels
+uint8_t lcd_surface_fb[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(135, 240, 16)] __attribute__((aligned(4)));
 
 int color_value = 0;
 
@@ -43,141 +55,457 @@ painter_device_t lcd_surface;
 led_t last_led_usb_state = {0};
 layer_state_t last_layer_state = {0};
 
-#define GRID_WIDTH 27
-#define GRID_HEIGHT 48
+#define GRID_WIDTH HLC_LIFE_W
+#define GRID_HEIGHT HLC_LIFE_H
 #define CELL_SIZE 4  // Cell size excluding outline
 #define OUTLINE_SIZE 1
 
-// Define the probability factor for initial alive cells
-#define INITIAL_ALIVE_PROBABILITY 0.2  // 20% chance of being alive
+// Percentage of cells alive after init_grid()
+#define INITIAL_ALIVE_PCT 20
 
-bool grid[GRID_HEIGHT][GRID_WIDTH];  // Current state
-bool new_grid[GRID_HEIGHT][GRID_WIDTH];  // Next state
-bool changed_grid[GRID_HEIGHT][GRID_WIDTH]; // Tracks changed cells
+#define LIFE_MS 100  // one generation per 100 ms: 10 fps
 
-uint32_t get_random_32bit(void) {
-    uint32_t random_value = 0;
-    for (int i = 0; i < 32; i++) {
-        wait_ms(1);
-        random_value = (random_value << 1) | (rosc_hw->randombit & 1);
-    }
-    return random_value;
+static hlc_life_t life;  // Current state + cells changed since last draw
+
+// Native (byte-swapped RGB565) surface pixel for an HSV colour, converted
+// the same way the surface driver converts qp_rect colours
+uint16_t hlc_native_color(uint8_t hue, uint8_t sat, uint8_t val) {
+    rgb_t    rgb    = hsv_to_rgb_nocie((hsv_t){hue, sat, val});
+    uint16_t rgb565 = (((uint16_t)rgb.r) & 0xF8) << 8 | (((uint16_t)rgb.g) & 0xFC) << 3 | (((uint16_t)rgb.b) & 0xF8) >> 3;
+    return __builtin_bswap16(rgb565);
 }
 
-void init_grid() {
-    // Initialize grid with alive cells
-    for (int y = 0; y < GRID_HEIGHT; y++) {
-        for (int x = 0; x < GRID_WIDTH; x++) {
-            grid[y][x] = (rand() < INITIAL_ALIVE_PROBABILITY * RAND_MAX);  // Use probability factor
-            changed_grid[y][x] = true;      // Mark all as changed initially
+// ─── Damage tracking ───
+// Rectangles touched since the last flush, kept as a few non-overlapping
+// windows so only changed pixels go out over SPI.
+static hlc_rect_t damage[HLC_DAMAGE_MAX_RECTS];
+static uint8_t    damage_count = 0;
+hlc_flush_stats_t hlc_flush_stats;
+
+static inline uint32_t rect_area(const hlc_rect_t *r) {
+    return (uint32_t)(r->right - r->left + 1) * (r->bottom - r->top + 1);
+}
+
+static inline hlc_rect_t rect_union(const hlc_rect_t *a, const hlc_rect_t *b) {
+    hlc_rect_t u = {
+        a->left < b->left ? a->left : b->left,       a->top < b->top ? a->top : b->top,
+        a->right > b->right ? a->right : b->right,   a->bottom > b->bottom ? a->bottom : b->bottom,
+    };
+    return u;
+}
+
+// Worth sending as one window: overlapping, touching, or close enough that
+// the extra pixels cost less than another viewport setup
+static inline bool rect_should_merge(const hlc_rect_t *a, const hlc_rect_t *b) {
+    hlc_rect_t u = rect_union(a, b);
+    return rect_area(&u) <= rect_area(a) + rect_area(b) + HLC_DAMAGE_MERGE_SLACK;
+}
+
+void hlc_damage_add(int16_t left, int16_t top, int16_t right, int16_t bottom) {
+    if (left < 0) left = 0;
+    if (top < 0) top = 0;
+    if (right >= LCD_WIDTH) right = LCD_WIDTH - 1;
+    if (bottom >= LCD_HEIGHT) bottom = LCD_HEIGHT - 1;
+    if (left > right || top > bottom) return;
+
+    hlc_rect_t r = {left, top, right, bottom};
+    for (;;) {
+        // Absorb every window this one should merge with; repeat until stable,
+        // since a grown window may now reach others
+        bool merged = false;
+        for (uint8_t i = 0; i < damage_count; i++) {
+            if (rect_should_merge(&damage[i], &r)) {
+                r = rect_union(&damage[i], &r);
+                damage[i] = damage[--damage_count];
+                merged = true;
+                break;
+            }
+        }
+        if (merged) continue;
+        if (damage_count < HLC_DAMAGE_MAX_RECTS) break;
+
+        // Out of slots: fold into the window whose union grows the least
+        uint8_t  best = 0;
+        uint32_t best_cost = UINT32_MAX;
+        for (uint8_t i = 0; i < damage_count; i++) {
+            hlc_rect_t u = rect_union(&damage[i], &r);
+            uint32_t cost = rect_area(&u) - rect_area(&damage[i]);
+            if (cost < best_cost) { best_cost = cost; best = i; }
         }
+        r = rect_union(&damage[best], &r);
+        damage[best] = damage[--damage_count];
     }
+    damage[damage_count++] = r;
 }
 
-void draw_grid() {
-    uint8_t hue = 0;  // Hue for alive cells
-    uint8_t sat = 0;  // Saturation for alive cells
-    uint8_t val_dead = 0;  // Brightness for dead cells
+void hlc_damage_all(void) {
+    damage_count = 0;
+    hlc_damage_add(0, 0, LCD_WIDTH - 1, LCD_HEIGHT - 1);
+}
 
-    for (int y = 0; y < GRID_HEIGHT; y++) {
-        for (int x = 0; x < GRID_WIDTH; x++) {
-            if (changed_grid[y][x]) { // Only update changed cells
-                uint16_t left = x * (CELL_SIZE + OUTLINE_SIZE);
-                uint16_t top = y * (CELL_SIZE + OUTLINE_SIZE);
-                uint16_t right = left + CELL_SIZE + OUTLINE_SIZE;
-                uint16_t bottom = top + CELL_SIZE + OUTLINE_SIZE;
-
-                // Draw the outline
-                qp_rect(lcd_surface, left, top, right, bottom, hue, sat, val_dead, true);
-
-                // Draw the filled cell inside the outline if it's alive
-                if (grid[y][x]) {
-                    switch (color_value) {
-                    case 0:
-                        qp_rect(lcd_surface, left + OUTLINE_SIZE, top + OUTLINE_SIZE, right - OUTLINE_SIZE, bottom - OUTLINE_SIZE, HSV_LAYER_0, true);
-                        break;
-                    case 1:
-                        qp_rect(lcd_surface, left + OUTLINE_SIZE, top + OUTLINE_SIZE, right - OUTLINE_SIZE, bottom - OUTLINE_SIZE, HSV_LAYER_1, true);
-                        break;
-                    case 2:
-                        qp_rect(lcd_surface, left + OUTLINE_SIZE, top + OUTLINE_SIZE, right - OUTLINE_SIZE, bottom - OUTLINE_SIZE, HSV_LAYER_2, true);
-                        break;
-                    case 3:
-                        qp_rect(lcd_surface, left + OUTLINE_SIZE, top + OUTLINE_SIZE, right - OUTLINE_SIZE, bottom - OUTLINE_SIZE, HSV_LAYER_3, true);
-                        break;
-                    case 4:
-                        qp_rect(lcd_surface, left + OUTLINE_SIZE, top + OUTLINE_SIZE, right - OUTLINE_SIZE, bottom - OUTLINE_SIZE, HSV_LAYER_4, true);
-                        break;
-                    case 5:
-                        qp_rect(lcd_surface, left + OUTLINE_SIZE, top + OUTLINE_SIZE, right - OUTLINE_SIZE, bottom - OUTLINE_SIZE, HSV_LAYER_5, true);
-                        break;
-                    case 6:
-                        qp_rect(lcd_surface, left + OUTLINE_SIZE, top + OUTLINE_SIZE, right - OUTLINE_SIZE, bottom - OUTLINE_SIZE, HSV_LAYER_6, true);
-                        break;
-                    case 7:
-                        qp_rect(lcd_surface, left + OUTLINE_SIZE, top + OUTLINE_SIZE, right - OUTLINE_SIZE, bottom - OUTLINE_SIZE, HSV_LAYER_7, true);
-                        break;
-                    default:
-                        qp_rect(lcd_surface, left + OUTLINE_SIZE, top + OUTLINE_SIZE, right - OUTLINE_SIZE, bottom - OUTLINE_SIZE, HSV_LAYER_UNDEF, true);
-                    }
-                }
-            }
+// ─── Flush batch ───
+// hlc_damage_flush() hands the damaged windows to a batch that is sent a
+// row at a time; damage arriving while a batch is still going out is held
+// back and sent when it finishes. Only a flush that was asked for and held
+// back is sent on its own: damage merely added meanwhile may belong to a
+// frame still being drawn, possibly on the other core.
+static hlc_rect_t flush_queue[HLC_DAMAGE_MAX_RECTS];
+static uint8_t    flush_queue_count = 0;
+static bool       flush_held        = false; // hlc_damage_flush() called mid-batch
+static uint8_t    flush_window      = 0;     // next window to send
+static uint16_t   flush_row         = 0;     // next row of that window
+static bool       flush_active      = false; // batch not fully sent
+
+// ─── Pass deadline ───
+// With a slice set, display_render() opens each housekeeping pass with one
+// µs deadline. The sync flush pumps before and after the user's drawing
+// stop at it, and the drawing reads it with hlc_pass_end(), so the whole
+// pass spends one slice rather than one per caller.
+static uint16_t pass_slice_us = 0;  // 0 = no deadline
+static uint32_t pass_end      = 0;
+
+void hlc_flush_slice(uint16_t us) {
+    pass_slice_us = us;
+}
+
+uint32_t hlc_pass_end(void) {
+    return pass_end;
+}
+
+static void pass_begin(void) {
+    pass_end = hlc_us_now() + pass_slice_us;
+}
+
+#ifdef HLC_ASYNC_FLUSH
+// ─── Asynchronous flush (RP2040 SPI DMA) ───
+// Damaged windows are staged row by row into a ping-pong shadow buffer and
+// sent with spiStartSend() while the caller goes on drawing the next frame.
+// The staged shadow half is the only memory the DMA reads, so the surface
+// is never touched in flight; rows changed before they are staged are also
+// in the next frame's damage and get sent again.
+#    define ST7789_CASET 0x2A
+#    define ST7789_RASET 0x2B
+#    define ST7789_RAMWR 0x2C
+
+// Windows are addressed in raw panel coordinates, surface offset added by
+// hand; QP's rotation handling is bypassed. LCD_ROTATION is an enum
+// constant, so the check cannot be a preprocessor #if.
+_Static_assert(LCD_ROTATION == QP_ROTATION_0, "HLC_ASYNC_FLUSH supports LCD_ROTATION QP_ROTATION_0 only");
+
+typedef struct {
+    uint16_t pixels;        // staged pixel count, 0 = empty
+    uint8_t  window;        // index into flush_queue
+    bool     opens_window;  // first chunk of its window: send CASET/RASET/RAMWR
+} flush_chunk_t;
+
+static uint16_t      flush_shadow[2][HLC_ASYNC_SHADOW_PIXELS];
+static flush_chunk_t flush_chunk[2];
+static uint8_t       flush_next     = 0;     // shadow half to send next
+static int8_t        flush_inflight = -1;    // shadow half on the wire
+
+// Copy the next rows of the queued windows into a free shadow half
+static void flush_stage(uint8_t half) {
+    flush_chunk_t *c = &flush_chunk[half];
+    if (c->pixels || flush_window >= flush_queue_count) return;
+
+    const uint16_t   *fb   = (const uint16_t *)lcd_surface_fb;
+    const hlc_rect_t *r    = &flush_queue[flush_window];
+    uint16_t          w    = r->right - r->left + 1;
+    uint16_t          rows = HLC_ASYNC_SHADOW_PIXELS / w;
+    if (rows > r->bottom - flush_row + 1) rows = r->bottom - flush_row + 1;
+
+    for (uint16_t i = 0; i < rows; i++)
+        memcpy(&flush_shadow[half][i * w], &fb[(flush_row + i) * LCD_WIDTH + r->left], w * sizeof(uint16_t));
+    c->pixels       = rows * w;
+    c->window       = flush_window;
+    c->opens_window = (flush_row == r->top);
+
+    flush_row += rows;
+    if (flush_row > r->bottom && ++flush_window < flush_queue_count)
+        flush_row = flush_queue[flush_window].top;
+}
+
+static void flush_command(uint8_t cmd, uint16_t start, uint16_t end) {
+    uint8_t data[4] = {start >> 8, start & 0xFF, end >> 8, end & 0xFF};
+    gpio_write_pin_low(LCD_DC_PIN);
+    spi_write(cmd);
+    gpio_write_pin_high(LCD_DC_PIN);
+    spi_transmit(data, sizeof(data));
+}
+
+// Advance the batch: retire a finished transfer, start the next staged
+// chunk, and stage the one after it while the DMA runs. Never blocks on DMA.
+void hlc_flush_pump(void) {
+    if (!flush_active) return;
+    if (flush_inflight >= 0) {
+        if (SPI_DRIVER.state == SPI_ACTIVE) {
+            flush_stage(!flush_inflight);
+            return;
         }
+        flush_chunk[flush_inflight].pixels = 0;
+        flush_inflight = -1;
     }
+
+    flush_stage(flush_next);
+    flush_chunk_t *c = &flush_chunk[flush_next];
+    if (!c->pixels) {
+        spi_stop();
+        flush_active = false;
+        // Damage deferred while this batch was on the wire goes out now,
+        // so a frame that stops drawing still reaches the panel
+        if (flush_held) hlc_damage_flush();
+        return;
+    }
+
+    if (c->opens_window) {
+        const hlc_rect_t *r = &flush_queue[c->window];
+        flush_command(ST7789_CASET, r->left + LCD_OFFSET_X, r->right + LCD_OFFSET_X);
+        flush_command(ST7789_RASET, r->top + LCD_OFFSET_Y, r->bottom + LCD_OFFSET_Y);
+        gpio_write_pin_low(LCD_DC_PIN);
+        spi_write(ST7789_RAMWR);
+        gpio_write_pin_high(LCD_DC_PIN);
+    }
+    spiStartSend(&SPI_DRIVER, c->pixels * sizeof(uint16_t), flush_shadow[flush_next]);
+    flush_inflight = flush_next;
+    flush_next ^= 1;
+    flush_stage(flush_next);
+}
+#else
+// ─── Synchronous flush, optionally sliced ───
+// Rows go out with qp_pixdata() in the caller's time. With a slice set, a
+// pump sends rows until the pass deadline and later passes send the rest,
+// so a large flush never holds up the main loop for long; a pump that
+// finds the deadline already passed sends nothing. The panel keeps its
+// write window between calls; rows drawn over before they are sent are
+// also in the next frame's damage and get sent again.
+static void flush_rows(bool sliced) {
+    if (!flush_active) return;
+    const uint16_t *fb = (const uint16_t *)lcd_surface_fb;
+    while (flush_window < flush_queue_count) {
+        if (sliced && pass_slice_us && (int32_t)(hlc_us_now() - pass_end) >= 0) return;
+        const hlc_rect_t *r = &flush_queue[flush_window];
+        if (flush_row == r->top) qp_viewport(lcd, r->left, r->top, r->right, r->bottom);
+        qp_pixdata(lcd, &fb[flush_row * LCD_WIDTH + r->left], r->right - r->left + 1);
+        if (++flush_row > r->bottom && ++flush_window < flush_queue_count)
+            flush_row = flush_queue[flush_window].top;
+    }
+    qp_flush(lcd);
+    flush_active = false;
+    if (flush_held) hlc_damage_flush();
 }
 
-void update_grid() {
-    for (int y = 0; y < GRID_HEIGHT; y++) {
-        for (int x = 0; x < GRID_WIDTH; x++) {
-            int alive_neighbors = 0;
-
-            // Count alive neighbors
-            for (int dy = -1; dy <= 1; dy++) {
-                for (int dx = -1; dx <= 1; dx++) {
-                    if (dy == 0 && dx == 0) continue;  // Skip the current cell
-                    int ny = y + dy;
-                    int nx = x + dx;
-                    if (ny >= 0 && ny < GRID_HEIGHT && nx >= 0 && nx < GRID_WIDTH) {
-                        alive_neighbors += grid[ny][nx];
-                    }
-                }
-            }
+void hlc_flush_pump(void) {
+    flush_rows(true);
+}
+#endif
 
-            // Apply the rules of the Game of Life
-            if (grid[y][x]) {
-                // Any live cell with two or three live neighbours survives.
-                new_grid[y][x] = (alive_neighbors == 2 || alive_neighbors == 3);
-            } else {
-                // Any dead cell with exactly three live neighbours becomes a live cell.
-                new_grid[y][x] = (alive_neighbors == 3);
-            }
+bool hlc_flush_busy(void) {
+    return flush_active;
+}
 
-            // Track changed cells
-            changed_grid[y][x] = (grid[y][x] != new_grid[y][x]);
+// Drain the current batch, past the pass deadline; required before any
+// other qp_* call on lcd
+void hlc_flush_wait(void) {
+#ifdef HLC_ASYNC_FLUSH
+    while (flush_active) hlc_flush_pump();
+#else
+    while (flush_active) flush_rows(false);
+#endif
+}
+
+// ─── Panel modes (ST7789) ───
+// Partial Display scans out only a band of rows and leaves the rest of the
+// glass black; Idle Mode drops to 8 colours (the MSB of each channel). Both
+// cut panel power for scenes that sit still for minutes. GRAM outside the
+// band is still kept up to date, so returning to normal needs no redraw.
+#define ST7789_PTLON  0x12
+#define ST7789_NORON  0x13
+#define ST7789_PTLAR  0x30
+#define ST7789_IDMOFF 0x38
+#define ST7789_IDMON  0x39
+
+static bool    panel_partial = false;
+static bool    panel_idle    = false;
+static int16_t panel_top, panel_bottom;
+
+static void panel_command(uint8_t cmd, const uint8_t *data, uint8_t len) {
+    hlc_flush_wait();
+    if (!spi_start(LCD_CS_PIN, false, LCD_SPI_MODE, LCD_SPI_DIVISOR)) return;
+    gpio_write_pin_low(LCD_DC_PIN);
+    spi_write(cmd);
+    gpio_write_pin_high(LCD_DC_PIN);
+    if (len) spi_transmit(data, len);
+    spi_stop();
+}
+
+// Every pixel of r shows unchanged in Idle Mode: each channel is 0 or full
+static bool panel_idle_safe(const hlc_rect_t *r) {
+    const uint16_t *fb = (const uint16_t *)lcd_surface_fb;
+    for (int16_t y = r->top; y <= r->bottom; y++) {
+        for (int16_t x = r->left; x <= r->right; x++) {
+            uint16_t c  = __builtin_bswap16(fb[y * LCD_WIDTH + x]);
+            uint16_t r5 = c >> 11, g6 = (c >> 5) & 0x3F, b5 = c & 0x1F;
+            if ((r5 && r5 != 0x1F) || (g6 && g6 != 0x3F) || (b5 && b5 != 0x1F)) return false;
+        }
+    }
+    return true;
+}
+
+// Before damage reaches the panel: keep Idle Mode only while the band can
+// show it exactly. Once idle, only the damaged part of the band can change,
+// unless the band itself moved: then every row of it is checked again.
+static void panel_update_idle(bool band_moved) {
+    bool safe = true;
+    if (panel_idle && !band_moved) {
+        for (uint8_t i = 0; i < damage_count && safe; i++) {
+            hlc_rect_t r = damage[i];
+            if (r.top < panel_top) r.top = panel_top;
+            if (r.bottom > panel_bottom) r.bottom = panel_bottom;
+            if (r.top <= r.bottom) safe = panel_idle_safe(&r);
         }
+    } else {
+        hlc_rect_t band = {0, panel_top, LCD_WIDTH - 1, panel_bottom};
+        safe = panel_idle_safe(&band);
+    }
+    if (safe != panel_idle) {
+        panel_command(safe ? ST7789_IDMON : ST7789_IDMOFF, NULL, 0);
+        panel_idle = safe;
+    }
+}
+
+// Show only rows top..bottom (surface coordinates, LCD_ROTATION 0)
+void hlc_panel_partial(int16_t top, int16_t bottom) {
+    if (panel_partial && top == panel_top && bottom == panel_bottom) return;
+    uint16_t start = top + LCD_OFFSET_Y, end = bottom + LCD_OFFSET_Y;
+    uint8_t  rows[4] = {start >> 8, start & 0xFF, end >> 8, end & 0xFF};
+    panel_command(ST7789_PTLAR, rows, sizeof(rows));
+    if (!panel_partial) panel_command(ST7789_PTLON, NULL, 0);
+    panel_partial = true;
+    panel_top     = top;
+    panel_bottom  = bottom;
+    panel_update_idle(true);
+}
+
+void hlc_panel_normal(void) {
+    if (!panel_partial) return;
+    if (panel_idle) panel_command(ST7789_IDMOFF, NULL, 0);
+    panel_command(ST7789_NORON, NULL, 0);
+    panel_partial = false;
+    panel_idle    = false;
+}
+
+// Send each damaged window from lcd_surface_fb to the panel, then reset.
+// Returns the pixel bytes queued; the panel is untouched when nothing changed.
+uint32_t hlc_damage_flush(void) {
+    uint32_t bytes = 0;
+    for (uint8_t i = 0; i < damage_count; i++) bytes += rect_area(&damage[i]) * sizeof(uint16_t);
+
+    if (flush_active) {
+        // Previous batch still going out: keep accumulating damage
+        hlc_flush_stats.deferred++;
+        flush_held = true;
+        return 0;
     }
+    flush_held = false;
+    if (panel_partial && damage_count) panel_update_idle(false);
+
+    hlc_flush_stats.last_windows = damage_count;
+    hlc_flush_stats.last_bytes   = bytes;
+    hlc_flush_stats.total_bytes += bytes;
+    hlc_flush_stats.flushes++;
+#ifdef HLC_DAMAGE_DEBUG
+    if (damage_count) dprintf("flush: %u windows, %lu bytes\n", damage_count, bytes);
+#endif
+    if (!damage_count) return 0;
+
+    // Damage is reset before the first pump, which may finish the batch
+    memcpy(flush_queue, damage, damage_count * sizeof(hlc_rect_t));
+    flush_queue_count = damage_count;
+    flush_window      = 0;
+    flush_row         = flush_queue[0].top;
+    damage_count      = 0;
+#ifdef HLC_ASYNC_FLUSH
+    flush_next        = 0;
+    flush_active      = spi_start(LCD_CS_PIN, false, LCD_SPI_MODE, LCD_SPI_DIVISOR);
+#else
+    flush_active      = true;
+#endif
+    hlc_flush_pump();
+    return bytes;
+}
+
+// ─── Cell tiles ───
+// A cell is a 5x5 tile: black top row and left column, 4x4 fill inside.
+// One tile per colour index, pre-rendered to native RGB565 at init.
+#define CELL_PITCH (CELL_SIZE + OUTLINE_SIZE)
+#define TILE_COLORS 9  // HSV_LAYER_0..7 + HSV_LAYER_UNDEF
+
+static const uint8_t tile_hsv[TILE_COLORS][3] = {
+    {HSV_LAYER_0}, {HSV_LAYER_1}, {HSV_LAYER_2}, {HSV_LAYER_3}, {HSV_LAYER_4},
+    {HSV_LAYER_5}, {HSV_LAYER_6}, {HSV_LAYER_7}, {HSV_LAYER_UNDEF},
+};
+
+static uint16_t cell_tiles[TILE_COLORS][CELL_PITCH][CELL_PITCH];
+static uint16_t alive_rows[CELL_PITCH][GRID_WIDTH * CELL_PITCH];  // current tile repeated across the grid
+static int      alive_rows_color = -1;
+
+static void init_tiles(void) {
+    for (int i = 0; i < TILE_COLORS; i++) {
+        uint16_t c = hlc_native_color(tile_hsv[i][0], tile_hsv[i][1], tile_hsv[i][2]);
+        for (int y = 0; y < CELL_PITCH; y++)
+            for (int x = 0; x < CELL_PITCH; x++)
+                cell_tiles[i][y][x] = (x < OUTLINE_SIZE || y < OUTLINE_SIZE) ? 0 : c;
+    }
+}
+
+void init_grid() {
+    init_tiles();
+    hlc_life_seed(&life, INITIAL_ALIVE_PCT);
+}
 
-    // Copy new grid state to current grid
+void draw_grid() {
+    int color = (color_value >= 0 && color_value < TILE_COLORS - 1) ? color_value : TILE_COLORS - 1;
+    if (color != alive_rows_color) {
+        for (int y = 0; y < CELL_PITCH; y++)
+            for (int x = 0; x < GRID_WIDTH * CELL_PITCH; x++)
+                alive_rows[y][x] = cell_tiles[color][y][x % CELL_PITCH];
+        alive_rows_color = color;
+    }
+
+    uint16_t *fb = (uint16_t *)lcd_surface_fb;
     for (int y = 0; y < GRID_HEIGHT; y++) {
-        for (int x = 0; x < GRID_WIDTH; x++) {
-            grid[y][x] = new_grid[y][x];
+        uint32_t changed = life.changed[y];
+        if (!changed) continue;  // Whole row unchanged
+        uint32_t alive = life.rows[y];
+        int16_t  top   = y * CELL_PITCH;
+
+        // Runs of changed cells, split where alive/dead flips
+        int x = __builtin_ctz(changed);
+        hlc_damage_add(x * CELL_PITCH, top, (31 - __builtin_clz(changed)) * CELL_PITCH + CELL_PITCH - 1, top + CELL_PITCH - 1);
+        while (x < GRID_WIDTH) {
+            if (!(changed & (1UL << x))) { x++; continue; }
+            bool is_alive = alive & (1UL << x);
+            int  end      = x + 1;
+            while (end < GRID_WIDTH && (changed & (1UL << end)) && (bool)(alive & (1UL << end)) == is_alive) end++;
+
+            size_t bytes = (size_t)(end - x) * CELL_PITCH * sizeof(uint16_t);
+            for (int row = 0; row < CELL_PITCH; row++) {
+                uint16_t *dst = &fb[(top + row) * LCD_WIDTH + x * CELL_PITCH];
+                if (is_alive) memcpy(dst, &alive_rows[row][x * CELL_PITCH], bytes);
+                else          memset(dst, 0, bytes);
+            }
+            x = end;
         }
     }
 }
 
+void update_grid() {
+    hlc_life_step(&life);
+}
+
 // Function to add a cluster of cells at a random position
 void add_cell_cluster() {
-    int cluster_size = 3;  // Size of the cluster (3x3)
-    int x = rand() % (GRID_WIDTH - cluster_size);
-    int y = rand() % (GRID_HEIGHT - cluster_size);
-
-    for (int dy = 0; dy < cluster_size; dy++) {
-        for (int dx = 0; dx < cluster_size; dx++) {
-            bool is_alive = rand() % 2; // Randomly choose between 0 and 1
-            grid[y + dy][x + dx] = is_alive;  // Set the cell to be alive
-            changed_grid[y + dy][x + dx] = true; // Mark the cell as changed
-        }
-    }
+    hlc_life_cluster(&life, 3);  // Size of the cluster (3x3)
 }
 
 #ifndef HLC_DISABLE_DEFAULT_DISPLAY
@@ -249,14 +577,50 @@ void update_display(void) {
 void update_display(void) {}
 #endif
 
+#ifdef HLC_RENDER_THREAD
+// ─── Render thread ───
+// Display work runs in a thread one priority below QMK's main loop, so
+// scanning always preempts it. A periodic virtual timer wakes it; it holds
+// render_mtx for each pass, which keeps the main thread's EEPROM writes
+// and the suspend path off the game state mid-frame. QMK's main loop never
+// blocks on its own, so each pass waits up to HLC_RENDER_SLICE_US for the
+// thread while it has work; the thread cuts the wait short when it is done.
+static THD_WORKING_AREA(render_wa, HLC_RENDER_STACK_SIZE);
+static thread_t       *render_tp = NULL;
+static virtual_timer_t render_vt;
+static BSEMAPHORE_DECL(render_tick, true);   // timer → thread: a period started
+static BSEMAPHORE_DECL(render_yield, true);  // thread → main loop: pass done
+static MUTEX_DECL(render_mtx);
+static volatile bool render_busy    = false;
+static volatile bool render_second  = false;  // latest second_display from the main loop
+static bool          render_stopped = false;  // suspended: main thread holds render_mtx
+static volatile uint32_t render_periods = 0;  // timer periods since the thread started
+
+_Static_assert(LIFE_MS % HLC_RENDER_PERIOD_MS == 0, "LIFE_MS must be a whole number of render periods");
+#endif
+
 // Called from halcyon.c
 void module_suspend_power_down_kb(void) {
+#ifdef HLC_RENDER_THREAD
+    // Called on every suspend loop pass; the thread stays out until wakeup
+    if (!render_stopped) {
+        chMtxLock(&render_mtx);
+        render_stopped = true;
+    }
+#endif
+    hlc_flush_wait();
     qp_power(lcd, false);
 }
 
 // Called from halcyon.c
 void module_suspend_wakeup_init_kb(void) {
     qp_power(lcd, true);
+#ifdef HLC_RENDER_THREAD
+    if (render_stopped) {
+        render_stopped = false;
+        chMtxUnlock(&render_mtx);
+    }
+#endif
 }
 
 // Called from halcyon.c
@@ -282,38 +646,61 @@ bool module_post_init_kb(void) {
     qp_surface_draw(lcd_surface, lcd, 0, 0, 0);
     qp_flush(lcd);
 
+    // Usable straight away; hlc_entropy_task() adds ROSC entropy as it arrives
+    hlc_random_seed(timer_read32());
+
     if(!module_post_init_user()) { return false; }
 
     return true;
 }
 
-// Called from halcyon.c
-bool display_module_housekeeping_task_kb(bool second_display) {
+// Whether the next Game of Life generation is due. In the render thread
+// the virtual timer is the clock: a generation starts on a period boundary
+// every LIFE_MS, however late in its period the thread got to run.
+static bool life_due(void) {
+#ifdef HLC_RENDER_THREAD
+    static uint32_t last_period = 0;
+    uint32_t periods = render_periods;
+    if (periods - last_period < LIFE_MS / HLC_RENDER_PERIOD_MS) return false;
+    last_period = periods;
+#else
+    static uint32_t last_draw = 0;
+    if (timer_elapsed32(last_draw) < LIFE_MS) return false;
+    last_draw = timer_read32();
+#endif
+    return true;
+}
+
+// One pass of display work: the main loop's, or the render thread's
+static bool display_render(bool second_display) {
+    // Keep any background flush moving before user code draws again; it
+    // shares the pass deadline with the drawing and the flush after it
+    pass_begin();
+    hlc_flush_pump();
+    if (!hlc_core1_running()) hlc_entropy_task();  // else core1 stirs the pool it draws from
+
     if(!display_module_housekeeping_task_user(second_display)) { return false; }
 
     if(second_display) {
-        static uint32_t last_draw = 0;
         static bool second_display_set = false;
         static uint32_t previous_matrix_activity_time = 0;
 
-        if(!second_display_set) {
-            srand(get_random_32bit());
+        // Seed the grid once the entropy pool has filled (a few ms after boot)
+        if(!second_display_set && hlc_entropy_ready()) {
             init_grid();
-            color_value = rand() % 8;
+            color_value = hlc_random_below(8);
             second_display_set = true;
         }
 
-        if (timer_elapsed32(last_draw) >= 100) { // Throttle to 10 fps
+        if (second_display_set && life_due()) {
             draw_grid();
             update_grid();
 
             if (previous_matrix_activity_time != last_matrix_activity_time()) {
-                color_value = rand() % 8;
+                color_value = hlc_random_below(8);
                 add_cell_cluster();
                 previous_matrix_activity_time = last_matrix_activity_time();
             }
-
-            last_draw = timer_read32();
         }
     }
 
@@ -322,9 +709,61 @@ bool display_module_housekeeping_task_kb(bool second_display) {
         update_display();
     }
 
-    // Move surface to lcd
+    // Move surface to lcd: directly drawn damage first, then QP's own dirty area
+    hlc_damage_flush();
+    hlc_flush_wait();
     qp_surface_draw(lcd_surface, lcd, 0, 0, 0);
     qp_flush(lcd);
 
     return true;
 }
+
+#ifdef HLC_RENDER_THREAD
+static void render_vt_cb(virtual_timer_t *vtp, void *p) {
+    chSysLockFromISR();
+    render_periods++;
+    render_busy = true;
+    chBSemResetI(&render_yield, true);  // drop a done signal nobody waited for
+    chBSemSignalI(&render_tick);
+    chSysUnlockFromISR();
+}
+
+static THD_FUNCTION(render_thread, arg) {
+    chRegSetThreadName("hlc_render");
+    for (;;) {
+        chBSemWait(&render_tick);
+        chMtxLock(&render_mtx);
+        display_render(render_second);
+        chMtxUnlock(&render_mtx);
+        render_busy = false;
+        chBSemSignal(&render_yield);
+    }
+}
+
+// Called from halcyon.c; starts the thread on the first pass after init
+bool display_module_housekeeping_task_kb(bool second_display) {
+    render_second = second_display;
+    if (!render_tp) {
+        render_tp = chThdCreateStatic(render_wa, sizeof(render_wa), NORMALPRIO - 1, render_thread, NULL);
+        chVTObjectInit(&render_vt);
+        chVTSetContinuous(&render_vt, TIME_MS2I(HLC_RENDER_PERIOD_MS), render_vt_cb, NULL);
+        return true;
+    }
+
+    // Journal writes stay on this thread with QMK's own EEPROM writes, and
+    // only go out while the render thread is between passes
+    if (hlc_journal_pending() && chMtxTryLock(&render_mtx)) {
+        hlc_journal_task();
+        chMtxUnlock(&render_mtx);
+    }
+
+    // Lend the render thread the CPU for a while; scanning resumes on time
+    if (render_busy) chBSemWaitTimeout(&render_yield, TIME_US2I(HLC_RENDER_SLICE_US));
+    return true;
+}
+#else
+// Called from halcyon.c
+bool display_module_housekeeping_task_kb(bool second_display) {
+    return display_render(second_display);
+}
+#endif
@@ -28,6 +28,68 @@
 
 extern painter_device_t lcd;
 extern painter_device_t lcd_surface;
+extern uint8_t lcd_surface_fb[];
+
+// Damage tracking: at most this many windows are streamed per flush
+#ifndef HLC_DAMAGE_MAX_RECTS
+#    define HLC_DAMAGE_MAX_RECTS 6
+#endif
+// Extra pixels worth sending to save a viewport setup (~11 bytes of commands)
+#ifndef HLC_DAMAGE_MERGE_SLACK
+#    define HLC_DAMAGE_MERGE_SLACK 64
+#endif
+
+// Async flush (HLC_ASYNC_FLUSH): pixels per half of the ping-pong shadow buffer.
+// hlc_flush_pump() runs once per housekeeping pass and starts at most one
+// chunk, so a batch moves at most this many pixels per main loop pass:
+// 2048 px is 4 KB, and a full 135x240 frame takes 16 passes however fast
+// the SPI is. Raise it for faster full-screen updates, at 4 bytes of RAM
+// per pixel.
+#ifndef HLC_ASYNC_SHADOW_PIXELS
+#    define HLC_ASYNC_SHADOW_PIXELS 2048
+#endif
+
+// Render thread (HLC_RENDER_THREAD): display work runs in its own ChibiOS
+// thread below the main loop's priority, woken every HLC_RENDER_PERIOD_MS
+#ifndef HLC_RENDER_PERIOD_MS
+#    define HLC_RENDER_PERIOD_MS 10
+#endif
+#ifndef HLC_RENDER_SLICE_US
+#    define HLC_RENDER_SLICE_US 400  // longest a main loop pass waits on it
+#endif
+#ifndef HLC_RENDER_STACK_SIZE
+#    define HLC_RENDER_STACK_SIZE 4096  // bytes
+#endif
+
+typedef struct {
+    int16_t left, top, right, bottom;  // inclusive
+} hlc_rect_t;
+
+typedef struct {
+    uint8_t  last_windows;
+    uint32_t last_bytes;
+    uint32_t total_bytes;
+    uint32_t flushes;
+    uint32_t deferred;  // flushes postponed because the previous batch was in flight
+} hlc_flush_stats_t;
+
+extern hlc_flush_stats_t hlc_flush_stats;
+
+uint16_t hlc_native_color(uint8_t hue, uint8_t sat, uint8_t val);
+void hlc_damage_add(int16_t left, int16_t top, int16_t right, int16_t bottom);
+void hlc_damage_all(void);
+uint32_t hlc_damage_flush(void);
+void hlc_flush_pump(void);
+bool hlc_flush_busy(void);
+void hlc_flush_wait(void);
+// Give each housekeeping pass a deadline `us` µs after it starts (0, the
+// default, sets none). The sync flush stops there and leaves the rest of
+// the batch to later passes; user drawing reads it with hlc_pass_end()
+// and stops there too, so the pumps and the drawing share one slice.
+void hlc_flush_slice(uint16_t us);
+uint32_t hlc_pass_end(void);
+void hlc_panel_partial(int16_t top, int16_t bottom);
+void hlc_panel_normal(void);
 
 void draw_grid(void);
 void update_grid(void);
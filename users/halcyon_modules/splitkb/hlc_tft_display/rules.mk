@@ -1,4 +1,6 @@
-SRC += $(USER_PATH)/splitkb/hlc_tft_display/hlc_tft_display.c
+SRC += $(USER_PATH)/splitkb/hlc_tft_display/hlc_tft_display.c \
+       $(USER_PATH)/splitkb/hlc_tft_display/hlc_life.c \
+       $(USER_PATH)/splitkb/hlc_tft_display/hlc_random.c
 POST_CONFIG_H += $(USER_PATH)/splitkb/hlc_tft_display/config.h
 
 # Fonts
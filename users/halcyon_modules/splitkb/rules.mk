@@ -11,9 +11,27 @@ BACKLIGHT_DRIVER = pwm
 
 VPATH += $(USER_PATH)/splitkb/
 SRC += $(USER_PATH)/splitkb/halcyon.c
+SRC += $(USER_PATH)/splitkb/hlc_perf.c
+SRC += $(USER_PATH)/splitkb/hlc_loop.c
+SRC += $(USER_PATH)/splitkb/hlc_core1.c
 HALCONFDIR += $(USER_PATH)/splitkb/halconf.h
 POST_CONFIG_H += $(USER_PATH)/splitkb/config.h
 
+# Display work on the RP2040's second core (see hlc_core1.h), experimental.
+# Every write to the wear-leveling backing store goes through hlc_core1.c
+# first, so core1 is parked in RAM while the flash is off.
+ifeq ($(strip $(HLC_CORE1_ENABLE)), yes)
+  OPT_DEFS += -DHLC_CORE1_ENABLE
+  EXTRALDFLAGS += -Wl,--wrap=backing_store_unlock -Wl,--wrap=backing_store_erase
+  EXTRALDFLAGS += -Wl,--wrap=backing_store_write -Wl,--wrap=backing_store_write_bulk
+endif
+
+# Save journal in EEPROM (see hlc_journal.h), for keymaps that keep state
+ifeq ($(strip $(HLC_JOURNAL_ENABLE)), yes)
+  OPT_DEFS += -DHLC_JOURNAL_ENABLE
+  SRC += $(USER_PATH)/splitkb/hlc_journal.c
+endif
+
 ifdef HLC_ENCODER
   include $(USER_PATH)/splitkb/hlc_encoder/rules.mk
 endif